@@ -3,16 +3,10 @@ const el = {
   wifi: document.getElementById('wifi-status'),
   espIp: document.getElementById('ip-address'),
   stm32Ip: document.getElementById('stm32-ip'),
+  nodeSelect: document.getElementById('node-select'),
   uptime: document.getElementById('uptime'),
   sensorHint: document.getElementById('sensor-hint'),
-  temp: document.getElementById('temp-value'),
-  humi: document.getElementById('humi-value'),
-  soil: document.getElementById('soil-value'),
-  lux: document.getElementById('lux-value'),
-  water: document.getElementById('water-value'),
-  light: document.getElementById('light-value'),
-  fan: document.getElementById('fan-value'),
-  buzzer: document.getElementById('buzzer-value'),
+  sensorContainer: document.getElementById('sensor-container'),
   dataAge: document.getElementById('data-age'),
   ackCard: document.getElementById('ack-card'),
   messageLog: document.getElementById('message-log'),
@@ -24,18 +18,33 @@ const el = {
   commandHint: document.getElementById('command-hint'),
   globalError: document.getElementById('global-error'),
   thresholdForm: document.getElementById('threshold-form'),
-  thresholdTemp: document.getElementById('threshold-temp'),
-  thresholdHumi: document.getElementById('threshold-humi'),
-  thresholdSoil: document.getElementById('threshold-soil'),
-  thresholdLux: document.getElementById('threshold-lux'),
   thresholdHint: document.getElementById('threshold-hint'),
   alarmStatus: document.getElementById('alarm-status'),
 };
 
 let lastMessageId = 0;
-const messageBuffer = [];
-const maxBufferSize = 120;
-const thresholdInputs = [el.thresholdTemp, el.thresholdHumi, el.thresholdSoil, el.thresholdLux].filter(Boolean);
+// 网关模式下的当前节点，初始值取自页面地址的 ?node= 参数。
+let currentNode = Number(new URLSearchParams(window.location.search).get('node')) || 0;
+let knownNodesKey = '';
+// 日志使用定长环形缓冲，界面只渲染可见区域内的行，新消息与状态更新合并到下一帧统一绘制。
+const maxBufferSize = 1000;
+const messageBuffer = new Array(maxBufferSize);
+let messageStart = 0;
+let messageCount = 0;
+const pendingMessages = [];
+const logRowHeight = 20;
+const logOverscan = 6;
+const logRowPool = [];
+const logSpacer = el.messageLog.querySelector('.message-log-spacer');
+let logStickToBottom = true;
+let pendingState = null;
+let renderScheduled = false;
+const ackFields = {};
+// 设备描述来自 /api/schema，指标卡片、控制对象与阈值输入框均据此生成。
+let schema = { metrics: [], actuators: [] };
+const metricValueNodes = new Map();
+const thresholdInputMap = new Map();
+const thresholdInputs = [];
 let thresholdFormDirty = false;
 const thresholdDefaultHint = '留空表示禁用，超限时将触发蜂鸣报警。';
 
@@ -82,15 +91,220 @@ function formatSwitchState(value) {
   return '--';
 }
 
+function formatMetricValue(value, spec) {
+  if (typeof value === 'number' && !Number.isNaN(value)) {
+    return `${value.toFixed(spec.decimals ?? 1)} ${spec.unit}`;
+  }
+  return `${value ?? '--'} ${spec.unit}`;
+}
+
+function createMetricCard(label) {
+  const card = document.createElement('div');
+  card.className = 'metric';
+  const labelNode = document.createElement('span');
+  labelNode.className = 'metric-label';
+  labelNode.textContent = label;
+  const valueNode = document.createElement('span');
+  valueNode.className = 'metric-value';
+  valueNode.textContent = '--';
+  card.append(labelNode, valueNode);
+  return { card, valueNode };
+}
+
+function buildSchemaView(nextSchema) {
+  schema = {
+    metrics: nextSchema.metrics ?? [],
+    actuators: nextSchema.actuators ?? [],
+  };
+
+  const ageCard = el.dataAge.parentElement;
+  [...schema.metrics, ...schema.actuators].forEach((spec) => {
+    const { card, valueNode } = createMetricCard(spec.label);
+    el.sensorContainer.insertBefore(card, ageCard);
+    metricValueNodes.set(spec.key, valueNode);
+  });
+
+  schema.actuators.forEach((spec) => {
+    const option = document.createElement('option');
+    option.value = spec.key;
+    option.textContent = spec.label;
+    el.commandTarget.append(option);
+  });
+  handleTargetChange();
+
+  if (el.thresholdForm) {
+    const submit = el.thresholdForm.querySelector('button[type="submit"]');
+    schema.metrics.forEach((spec) => {
+      const label = document.createElement('label');
+      label.append(`${spec.label}上限 (${spec.unit})`);
+      const input = document.createElement('input');
+      input.type = 'number';
+      input.step = spec.decimals > 0 ? String(10 ** -spec.decimals) : '1';
+      input.min = spec.min;
+      input.max = spec.max;
+      input.placeholder = '留空禁用';
+      input.addEventListener('input', markThresholdDirty);
+      label.append(input);
+      el.thresholdForm.insertBefore(label, submit);
+      thresholdInputMap.set(spec.key, input);
+      thresholdInputs.push(input);
+    });
+  }
+}
+
+async function loadSchema() {
+  const response = await fetch('/api/schema');
+  if (!response.ok) {
+    throw new Error(`SCHEMA ${response.status}`);
+  }
+  buildSchemaView(await response.json());
+}
+
+function withNode(path) {
+  const separator = path.includes('?') ? '&' : '?';
+  return `${path}${separator}node=${currentNode}`;
+}
+
+function updateNodeSelect(nodes) {
+  const ids = Array.isArray(nodes) ? [...nodes] : [];
+  if (!ids.includes(currentNode)) {
+    ids.push(currentNode);
+  }
+  ids.sort((a, b) => a - b);
+  const key = ids.join(',');
+  if (key === knownNodesKey) {
+    return;
+  }
+  knownNodesKey = key;
+  el.nodeSelect.textContent = '';
+  ids.forEach((id) => {
+    const option = document.createElement('option');
+    option.value = String(id);
+    option.textContent = `盆栽 ${id}`;
+    el.nodeSelect.append(option);
+  });
+  el.nodeSelect.value = String(currentNode);
+}
+
+function handleNodeChange() {
+  currentNode = Number(el.nodeSelect.value) || 0;
+  const url = new URL(window.location.href);
+  url.searchParams.set('node', String(currentNode));
+  window.history.replaceState(null, '', url);
+
+  lastMessageId = 0;
+  messageStart = 0;
+  messageCount = 0;
+  pendingMessages.length = 0;
+  logStickToBottom = true;
+  logSpacer.style.height = '0px';
+  // 切换节点后立即清空上一节点的卡片、回执与阈值，避免新节点数据到达前显示旧值。
+  pendingState = null;
+  thresholdFormDirty = false;
+  updateSensorView({});
+  updateAckView({});
+  updateThresholdView({});
+  scheduleRender();
+  fetchState();
+  fetchMessages();
+}
+
+function setText(node, text) {
+  if (node && node.textContent !== text) {
+    node.textContent = text;
+  }
+}
+
+function scheduleRender() {
+  if (!renderScheduled) {
+    renderScheduled = true;
+    requestAnimationFrame(flushRender);
+  }
+}
+
+function pushMessage(line) {
+  if (messageCount < maxBufferSize) {
+    messageBuffer[(messageStart + messageCount) % maxBufferSize] = line;
+    messageCount += 1;
+  } else {
+    messageBuffer[messageStart] = line;
+    messageStart = (messageStart + 1) % maxBufferSize;
+  }
+}
+
+function messageAt(index) {
+  return messageBuffer[(messageStart + index) % maxBufferSize];
+}
+
+function renderLogWindow() {
+  const log = el.messageLog;
+  const scrollTop = log.scrollTop;
+  const first = Math.max(0, Math.floor(scrollTop / logRowHeight) - logOverscan);
+  const last = Math.min(messageCount, Math.ceil((scrollTop + log.clientHeight) / logRowHeight) + logOverscan);
+  const needed = Math.max(0, last - first);
+
+  while (logRowPool.length < needed) {
+    const row = document.createElement('div');
+    row.className = 'message-log-row';
+    log.append(row);
+    logRowPool.push(row);
+  }
+
+  logRowPool.forEach((row, i) => {
+    if (i >= needed) {
+      row.hidden = true;
+      return;
+    }
+    const index = first + i;
+    const offset = index * logRowHeight;
+    row.hidden = false;
+    setText(row, messageAt(index));
+    if (row.dataset.offset !== String(offset)) {
+      row.dataset.offset = String(offset);
+      row.style.transform = `translateY(${offset}px)`;
+    }
+  });
+}
+
+function flushRender() {
+  renderScheduled = false;
+
+  if (pendingState) {
+    const state = pendingState;
+    pendingState = null;
+    updateStatusView(state);
+    updateSensorView(state);
+    updateAckView(state);
+    updateThresholdView(state);
+  }
+
+  if (pendingMessages.length > 0) {
+    pendingMessages.forEach(pushMessage);
+    pendingMessages.length = 0;
+    logSpacer.style.height = `${messageCount * logRowHeight}px`;
+    if (logStickToBottom) {
+      el.messageLog.scrollTop = el.messageLog.scrollHeight;
+    }
+  }
+
+  renderLogWindow();
+}
+
+function handleLogScroll() {
+  const log = el.messageLog;
+  logStickToBottom = log.scrollTop + log.clientHeight >= log.scrollHeight - logRowHeight;
+  scheduleRender();
+}
+
 function appendMessageToLog(jsonLine) {
   if (!jsonLine) {
     return;
   }
-  messageBuffer.push(jsonLine);
-  if (messageBuffer.length > maxBufferSize) {
-    messageBuffer.splice(0, messageBuffer.length - maxBufferSize);
+  pendingMessages.push(jsonLine);
+  if (pendingMessages.length > maxBufferSize) {
+    pendingMessages.splice(0, pendingMessages.length - maxBufferSize);
   }
-  el.messageLog.textContent = messageBuffer.join('\n');
+  scheduleRender();
 }
 
 function showError(message) {
@@ -103,47 +317,63 @@ function showError(message) {
 
 function updateStatusView(state) {
   const wifi = state.wifi ?? {};
-  el.wifi.textContent = wifi.connected ? '已连接' : '未连接';
-  el.espIp.textContent = wifi.ip || '未知';
-  el.stm32Ip.textContent = state.stm32ReportedIp || '未上报';
-  el.uptime.textContent = formatDuration(state.uptimeSeconds ?? 0);
+  setText(el.wifi, wifi.connected ? '已连接' : '未连接');
+  setText(el.espIp, wifi.ip || '未知');
+  setText(el.stm32Ip, state.stm32ReportedIp || '未上报');
+  updateNodeSelect(state.nodes);
+  setText(el.uptime, formatDuration(state.uptimeSeconds ?? 0));
 }
 
 function updateSensorView(state) {
+  // 节点尚无数据时各卡片回到 "--"；thresholds 为 null 表示网关还没有该节点的任何状态。
+  const data = state.latestData ?? {};
   if (!state.latestData) {
-    el.sensorHint.textContent = '等待 STM32 上传数据...';
-    el.sensorHint.hidden = false;
-    return;
+    setText(el.sensorHint, state.thresholds === null
+      ? `盆栽 ${currentNode} 尚未上线，等待 STM32 上传数据...`
+      : '等待 STM32 上传数据...');
   }
+  el.sensorHint.hidden = Boolean(state.latestData);
+  schema.metrics.forEach((spec) => {
+    setText(metricValueNodes.get(spec.key), formatMetricValue(data[spec.key], spec));
+  });
+  schema.actuators.forEach((spec) => {
+    setText(metricValueNodes.get(spec.key), formatSwitchState(data[spec.key]));
+  });
+  setText(el.dataAge, formatAge(data.ageMs));
+}
 
-  const data = state.latestData;
-  el.sensorHint.hidden = true;
-  el.temp.textContent = `${data.temp?.toFixed?.(1) ?? data.temp ?? '--'} ℃`;
-  el.humi.textContent = `${data.humi?.toFixed?.(1) ?? data.humi ?? '--'} %`;
-  el.soil.textContent = `${data.soil ?? '--'} %`;
-  el.lux.textContent = `${data.lux?.toFixed?.(1) ?? data.lux ?? '--'} lx`;
-  el.water.textContent = formatSwitchState(data.water);
-  el.light.textContent = formatSwitchState(data.light);
-  el.fan.textContent = formatSwitchState(data.fan);
-  el.buzzer.textContent = formatSwitchState(data.buzzer);
-  el.dataAge.textContent = formatAge(data.ageMs);
+function ensureAckFields() {
+  if (ackFields.target) {
+    return;
+  }
+  el.ackCard.textContent = '';
+  [['target', '目标'], ['action', '动作'], ['result', '结果'], ['age', '延迟']].forEach(([key, label], index) => {
+    if (index > 0) {
+      el.ackCard.append(document.createElement('br'));
+    }
+    const strong = document.createElement('strong');
+    strong.textContent = `${label}：`;
+    const value = document.createElement('span');
+    el.ackCard.append(strong, value);
+    ackFields[key] = value;
+  });
 }
 
 function updateAckView(state) {
   if (!state.latestAck) {
+    Object.keys(ackFields).forEach((key) => delete ackFields[key]);
     el.ackCard.classList.remove('ok');
-    el.ackCard.textContent = '尚未收到回执。';
+    setText(el.ackCard, '尚未收到回执。');
     return;
   }
 
   const ack = state.latestAck;
+  ensureAckFields();
   el.ackCard.classList.toggle('ok', ack.result === 'ok');
-  el.ackCard.innerHTML = `
-    <strong>目标：</strong>${ack.target}<br>
-    <strong>动作：</strong>${ack.action}<br>
-    <strong>结果：</strong>${ack.result}<br>
-    <strong>延迟：</strong>${formatAge(ack.ageMs)}
-  `;
+  setText(ackFields.target, ack.target ?? '--');
+  setText(ackFields.action, ack.action ?? '--');
+  setText(ackFields.result, ack.result ?? '--');
+  setText(ackFields.age, formatAge(ack.ageMs));
 }
 
 function resetThresholdHint() {
@@ -157,7 +387,7 @@ function updateAlarmView(alarm) {
     return;
   }
   if (!alarm) {
-    el.alarmStatus.textContent = '暂无报警记录。';
+    setText(el.alarmStatus, '暂无报警记录。');
     return;
   }
 
@@ -180,7 +410,7 @@ function updateAlarmView(alarm) {
     parts.push(`蜂鸣：${alarm.pulseMs} ms`);
   }
 
-  el.alarmStatus.innerHTML = parts.join('<br>');
+  setText(el.alarmStatus, parts.join('\n'));
 }
 
 function updateThresholdView(state) {
@@ -203,10 +433,7 @@ function updateThresholdView(state) {
       }
     };
 
-    assign(el.thresholdTemp, thresholds.temp);
-    assign(el.thresholdHumi, thresholds.humi);
-    assign(el.thresholdSoil, thresholds.soil);
-    assign(el.thresholdLux, thresholds.lux);
+    thresholdInputMap.forEach((input, key) => assign(input, thresholds[key]));
     thresholdFormDirty = false;
     resetThresholdHint();
   }
@@ -230,7 +457,7 @@ function readThresholdInput(input, label) {
 }
 
 async function updateThresholdsOnServer(payload) {
-  const response = await fetch('/api/thresholds', {
+  const response = await fetch(withNode('/api/thresholds'), {
     method: 'POST',
     headers: { 'Content-Type': 'application/json' },
     body: JSON.stringify(payload),
@@ -245,12 +472,10 @@ async function updateThresholdsOnServer(payload) {
 async function handleThresholdSubmit(event) {
   event.preventDefault();
   try {
-    const payload = {
-      temp: readThresholdInput(el.thresholdTemp, '温度阈值'),
-      humi: readThresholdInput(el.thresholdHumi, '湿度阈值'),
-      soil: readThresholdInput(el.thresholdSoil, '土壤阈值'),
-      lux: readThresholdInput(el.thresholdLux, '光照阈值'),
-    };
+    const payload = {};
+    schema.metrics.forEach((spec) => {
+      payload[spec.key] = readThresholdInput(thresholdInputMap.get(spec.key), `${spec.label}阈值`);
+    });
     const data = await updateThresholdsOnServer(payload);
     thresholdFormDirty = false;
     el.thresholdHint.textContent = '阈值已更新并已提交到设备。';
@@ -268,15 +493,18 @@ function markThresholdDirty() {
 
 async function fetchState() {
   try {
-    const response = await fetch('/api/state');
+    const node = currentNode;
+    const response = await fetch(withNode('/api/state'));
     if (!response.ok) {
       throw new Error(`STATE ${response.status}`);
     }
     const state = await response.json();
-    updateStatusView(state);
-    updateSensorView(state);
-    updateAckView(state);
-    updateThresholdView(state);
+    // 请求期间已切换节点时丢弃旧节点的响应。
+    if (node !== currentNode) {
+      return;
+    }
+    pendingState = state;
+    scheduleRender();
   } catch (error) {
     showError(`状态刷新失败：${error.message}`);
   }
@@ -284,7 +512,7 @@ async function fetchState() {
 
 async function fetchMessages() {
   try {
-    const response = await fetch(`/api/messages?after=${lastMessageId}`);
+    const response = await fetch(withNode(`/api/messages?after=${lastMessageId}`));
     if (!response.ok) {
       throw new Error(`MESSAGES ${response.status}`);
     }
@@ -306,21 +534,14 @@ async function fetchMessages() {
       .split('\n')
       .map((line) => line.trim())
       .filter((line) => line.length > 0)
-      .forEach((line) => {
-        try {
-          const json = JSON.parse(line);
-          appendMessageToLog(JSON.stringify(json, null, 2));
-        } catch (error) {
-          appendMessageToLog(line);
-        }
-      });
+      .forEach(appendMessageToLog);
   } catch (error) {
     showError(`消息刷新失败：${error.message}`);
   }
 }
 
 async function sendCommand(payload) {
-  const response = await fetch('/api/cmd', {
+  const response = await fetch(withNode('/api/cmd'), {
     method: 'POST',
     headers: { 'Content-Type': 'application/json' },
     body: JSON.stringify(payload),
@@ -330,7 +551,13 @@ async function sendCommand(payload) {
     throw new Error(msg || `HTTP ${response.status}`);
   }
   const data = await response.json();
-  el.commandHint.textContent = `命令已发送，消息序号 ${data.queuedId ?? '未知'}`;
+  if (data.result === 'suppressed') {
+    el.commandHint.textContent = '设备已处于目标状态，命令未重复下发。';
+  } else if (data.result === 'coalesced') {
+    el.commandHint.textContent = `相同命令等待回执中，已合并到消息 ${data.queuedId ?? '未知'}`;
+  } else {
+    el.commandHint.textContent = `命令已发送，消息序号 ${data.queuedId ?? '未知'}`;
+  }
 }
 
 function handleCommandSubmit(event) {
@@ -353,21 +580,33 @@ function handleActionChange() {
   el.timeWrapper.hidden = !isPulse;
 }
 
-function bootstrap() {
+function handleTargetChange() {
+  const spec = schema.actuators.find((item) => item.key === el.commandTarget.value);
+  if (spec?.maxPulseMs) {
+    el.commandTime.max = spec.maxPulseMs;
+  }
+}
+
+async function bootstrap() {
   el.commandForm.addEventListener('submit', handleCommandSubmit);
   el.commandAction.addEventListener('change', handleActionChange);
+  el.commandTarget.addEventListener('change', handleTargetChange);
+  el.messageLog.addEventListener('scroll', handleLogScroll, { passive: true });
+  el.nodeSelect.addEventListener('change', handleNodeChange);
+  updateNodeSelect([]);
   handleActionChange();
 
   if (el.thresholdForm) {
     el.thresholdForm.addEventListener('submit', handleThresholdSubmit);
-    thresholdInputs.forEach((input) => {
-      if (input) {
-        input.addEventListener('input', markThresholdDirty);
-      }
-    });
     resetThresholdHint();
   }
 
+  try {
+    await loadSchema();
+  } catch (error) {
+    showError(`设备描述加载失败：${error.message}`);
+  }
+
   fetchState();
   fetchMessages();
   setInterval(fetchState, 5000);
@@ -0,0 +1,50 @@
+// 原理说明：REST 路由模块以编译期常量表描述全部 /api/ 接口，按前缀一次判定后在表内匹配方法与路径，支持单个路径参数，无需为每个接口分配处理器对象。
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+
+namespace api_router {
+
+constexpr char kPrefix[] = "/api/";
+constexpr size_t kPrefixLength = sizeof(kPrefix) - 1;
+
+enum RouteFlags : uint8_t {
+  kRouteNone = 0,
+  kRouteCacheable = 1 << 0,
+};
+
+// 路径参数直接指向请求 URI 内部，仅在本次处理期间有效。
+struct RouteParams {
+  const char* value = nullptr;
+  size_t length = 0;
+
+  bool toUint(uint32_t& out) const;
+};
+
+using RouteHandler = void (*)(const RouteParams& params);
+
+// pattern 不含 kPrefix，形如 "messages/<id>"，<name> 匹配一个路径段。
+struct Route {
+  HTTPMethod method;
+  const char* pattern;
+  RouteHandler handler;
+  uint8_t flags;
+};
+
+enum class MatchResult : uint8_t {
+  kMatched = 0,
+  kMethodNotAllowed,
+  kNotFound,
+};
+
+// path 为去掉 kPrefix 后的部分；匹配成功时写入表内下标与路径参数。
+MatchResult match(const Route* routes,
+                  size_t count,
+                  HTTPMethod method,
+                  const char* path,
+                  size_t& index,
+                  RouteParams& params);
+const char* methodName(HTTPMethod method);
+
+}  // namespace api_router
@@ -0,0 +1,24 @@
+// 原理说明：启动剖析模块记录上电后各启动阶段完成的时间点，用于评估掉电重启后恢复服务所需的时间。
+#pragma once
+
+#include <Arduino.h>
+
+namespace boot_profile {
+
+enum Phase : uint8_t {
+  kSerialReady = 0,
+  kWifiReady,
+  kServerReady,
+  kFsMounted,
+  kFirstResponse,
+  kPhaseCount,
+};
+
+// 每个阶段只记录第一次到达的时间，重复调用无效。
+void mark(Phase phase);
+bool reached(Phase phase);
+// 自上电起的毫秒数，未到达时返回 0。
+unsigned long at(Phase phase);
+const char* phaseName(Phase phase);
+
+}  // namespace boot_profile
@@ -0,0 +1,66 @@
+// 原理说明：命令限流模块为每个节点的每个执行机构维护令牌桶与待回执命令，合并重复命令、过滤与当前状态一致的命令，保护执行机构与串口带宽。
+#pragma once
+
+#include <Arduino.h>
+
+namespace command_limiter {
+
+enum class Action : uint8_t {
+  kOn = 0,
+  kOff,
+  kPulse,
+};
+
+enum class Verdict : uint8_t {
+  kSend = 0,
+  kCoalesced,
+  kSuppressed,
+  kRateLimited,
+};
+
+struct Result {
+  Verdict verdict = Verdict::kSend;
+  uint32_t message_id = 0;
+  uint32_t retry_after_ms = 0;
+};
+
+constexpr uint8_t kBucketCapacity = 4;
+
+// 单个执行机构的限流与待回执状态，由调用方按节点、按执行机构持有。
+struct TargetState {
+  uint8_t tokens = kBucketCapacity;
+  unsigned long refilled_at = 0;
+  bool pending = false;
+  Action pending_action = Action::kOff;
+  uint16_t pending_pulse_ms = 0;
+  uint32_t pending_message_id = 0;
+  unsigned long sent_at = 0;
+  bool ever_sent = false;
+  // 最近一次下发之后是否已收到 ack，以及收到的时间。
+  bool acked_since_sent = false;
+  unsigned long acked_at = 0;
+};
+
+struct Counters {
+  uint32_t sent = 0;
+  uint32_t coalesced = 0;
+  uint32_t suppressed = 0;
+  uint32_t rate_limited = 0;
+};
+
+bool parseAction(const char* text, Action& action);
+
+// switch_state 为最近一次 data 帧中的开关状态，未知时传 -1。
+// off 是安全方向，只会与待回执的相同命令合并，不会因状态一致或令牌耗尽被拒绝。
+Result evaluate(TargetState& state,
+                Action action,
+                uint16_t pulse_ms,
+                int switch_state,
+                unsigned long state_updated_at,
+                unsigned long now_ms);
+// 命令确实写入串口后调用，此时才扣除令牌。
+void markSent(TargetState& state, Action action, uint16_t pulse_ms, uint32_t message_id, unsigned long now_ms);
+void markAcked(TargetState& state, unsigned long now_ms);
+const Counters& counters();
+
+}  // namespace command_limiter
@@ -0,0 +1,50 @@
+// 原理说明：设备注册表以静态表描述全部传感指标与执行机构，新增设备只需在表中追加一行，名称查找通过编译期生成的完美哈希索引完成。
+#pragma once
+
+#include <Arduino.h>
+
+#include "sensor_filter.h"
+
+namespace device_registry {
+
+struct MetricSpec {
+  const char* key;
+  const char* label;
+  const char* unit;
+  uint8_t decimals;
+  float threshold_min;
+  float threshold_max;
+  sensor_filter::FilterSpec filter;
+};
+
+struct ActuatorSpec {
+  const char* key;
+  const char* label;
+  uint16_t max_pulse_ms;
+};
+
+// 传感指标：对应 data 帧中的数值字段，同时决定可配置的报警阈值范围与滤波参数（中值窗口、平滑系数、每秒最大变化量）。
+constexpr MetricSpec kMetrics[] = {
+    {"temp", "温度", "℃", 1, -40.0f, 125.0f, {3, 0.5f, 1.0f}},
+    {"humi", "湿度", "%", 1, 0.0f, 100.0f, {3, 0.5f, 5.0f}},
+    {"soil", "土壤湿度", "%", 0, 0.0f, 100.0f, {5, 0.4f, 0.0f}},
+    {"lux", "光照", "lx", 1, 0.0f, 200000.0f, {5, 0.6f, 0.0f}},
+};
+
+// 执行机构：对应 cmd 帧的 target 以及 data 帧中的开关状态字段。
+constexpr ActuatorSpec kActuators[] = {
+    {"water", "水泵", 10000},
+    {"light", "补光灯", 10000},
+    {"fan", "风扇", 10000},
+    {"buzzer", "蜂鸣器", 10000},
+};
+
+constexpr size_t kMetricCount = sizeof(kMetrics) / sizeof(kMetrics[0]);
+constexpr size_t kActuatorCount = sizeof(kActuators) / sizeof(kActuators[0]);
+constexpr int kNotFound = -1;
+
+// 返回表内下标，未注册的名称返回 kNotFound。
+int findMetric(const char* key);
+int findActuator(const char* key);
+
+}  // namespace device_registry
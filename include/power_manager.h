@@ -0,0 +1,31 @@
+// 原理说明：功耗管理模块根据热点客户端数量与串口活动决定工作模式和主循环轮询间隔，调度逻辑只依赖传入的时间戳，可在主机上用模拟时钟验证。
+#pragma once
+
+#include <Arduino.h>
+
+namespace power_manager {
+
+enum class Mode : uint8_t {
+  kActive = 0,
+  kIdle,
+};
+
+struct Decision {
+  Mode mode = Mode::kActive;
+  uint16_t poll_delay_ms = 0;
+  bool mode_changed = false;
+};
+
+void begin(unsigned long now_ms);
+// 每次主循环调用一次，返回本轮应采用的模式与休眠时长。
+Decision update(unsigned long now_ms, uint8_t station_count, bool uart_activity);
+// 记录一轮主循环中实际工作与休眠的时长，用于估算占空比。
+void recordLoop(uint32_t busy_us, uint32_t sleep_us);
+
+Mode mode();
+const char* modeName(Mode mode);
+// 发送给 STM32 的 cfg 帧中的上报周期（秒）。
+uint16_t reportIntervalSeconds(Mode mode);
+float dutyCycle();
+
+}  // namespace power_manager
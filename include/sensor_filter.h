@@ -0,0 +1,29 @@
+// 原理说明：滤波模块位于串口解析与状态快照之间，对每个指标依次做中值、变化率限制与指数平滑，状态大小固定，抑制单点噪声误触发报警。
+#pragma once
+
+#include <Arduino.h>
+
+namespace sensor_filter {
+
+constexpr uint8_t kMaxMedianWindow = 5;
+
+struct FilterSpec {
+  uint8_t median_window;   // 1 表示不做中值滤波，最大 kMaxMedianWindow
+  float ema_alpha;         // 1.0 表示不做平滑
+  float max_rate_per_s;    // 每秒最大变化量，0 表示不限制
+};
+
+// 单个指标的滤波状态，由调用方持有；重置时直接赋值为默认构造的对象。
+struct FilterState {
+  float window[kMaxMedianWindow] = {};
+  uint8_t filled = 0;
+  uint8_t next = 0;
+  bool has_output = false;
+  float output = 0.0f;
+  unsigned long updated_at = 0;
+};
+
+// 输入一次原始采样，返回滤波后的值。
+float apply(FilterState& state, const FilterSpec& spec, float raw, unsigned long now_ms);
+
+}  // namespace sensor_filter
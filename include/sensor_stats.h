@@ -0,0 +1,51 @@
+// 原理说明：统计模块按数据帧增量维护各指标的滚动窗口统计量，避免客户端为求均值而下载全部历史；状态由调用方持有，便于按节点分别统计。
+#pragma once
+
+#include <Arduino.h>
+
+namespace sensor_stats {
+
+enum Window : uint8_t {
+  kWindowHour = 0,
+  kWindowDay,
+  kWindowCount,
+};
+
+constexpr uint8_t kHourBuckets = 6;
+constexpr uint8_t kDayBuckets = 12;
+
+struct Bucket {
+  uint16_t epoch = 0;
+  uint16_t count = 0;
+  float mean = 0.0f;
+  float m2 = 0.0f;
+  float min = 0.0f;
+  float max = 0.0f;
+  uint32_t above_ms = 0;
+};
+
+// 单个指标的全部统计状态，大小固定。
+struct MetricStats {
+  Bucket hour[kHourBuckets];
+  Bucket day[kDayBuckets];
+  bool has_last = false;
+  bool last_above = false;
+  unsigned long last_at = 0;
+};
+
+struct Summary {
+  uint32_t count = 0;
+  float min = 0.0f;
+  float max = 0.0f;
+  float mean = 0.0f;
+  float stddev = 0.0f;
+  uint32_t above_ms = 0;
+};
+
+// 记录一次采样；threshold_enabled 为真时累计超过阈值的持续时间。
+void record(MetricStats& stats, float value, bool threshold_enabled, float threshold, unsigned long now_ms);
+// 合并窗口内的分桶得到统计结果，窗口内无样本时返回 false。
+bool summarize(const MetricStats& stats, Window window, unsigned long now_ms, Summary& out);
+const char* windowName(Window window);
+
+}  // namespace sensor_stats
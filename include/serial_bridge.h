@@ -9,8 +9,20 @@ namespace serial_bridge {
 
 using MessageHandler = void (*)(const String& json_line);
 
+// 链路统计：用于观察丢帧、超长行等串口异常。
+struct LinkStats {
+  uint32_t bytes_received = 0;
+  uint32_t frames_delivered = 0;
+  uint32_t frames_dropped = 0;
+  uint32_t rx_overruns = 0;  // 硬件接收缓冲溢出次数（两次读取之间至少丢过一个字节）
+  uint16_t longest_line = 0;
+};
+
 void begin(HardwareSerial& serial_port, unsigned long baud_rate);
 void loop();
+// 将一段原始字节送入行组装逻辑，loop() 读取串口后也经由此入口，便于回放抓包数据。
+void feedBytes(const char* data, size_t length);
+const LinkStats& stats();
 void setMessageHandler(MessageHandler handler);
 bool sendJson(const JsonDocument& doc);
 bool sendRawLine(const String& line);
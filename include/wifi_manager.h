@@ -7,7 +7,15 @@
 namespace wifi_manager {
 
 void startAccessPoint(const char* ssid, const char* password = nullptr);
+// SDK 会在上电时按 Flash 中保存的配置自动恢复热点；若 SSID 与密码均未变化则直接沿用，
+// 省去拆除重建热点的数百毫秒。返回 false 时调用方应回退到 startAccessPoint()。
+bool resumeAccessPoint(const char* ssid, const char* password = nullptr);
+// 本次启动是否沿用了已保存的热点配置。
+bool accessPointResumed();
 bool isConnected();
 IPAddress localIP();
+uint8_t stationCount();
+// 空闲时允许 SDK 在信标间隙进入浅睡眠，活跃时恢复 SDK 默认的 modem sleep；纯 AP 模式下射频仍需保持，实际节能有限。
+void setLowPower(bool enabled);
 
 }  // namespace wifi_manager
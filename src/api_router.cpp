@@ -0,0 +1,104 @@
+// 原理说明：逐段比较路由模板与请求路径，模板中的 <name> 段捕获为参数；路径命中但方法不符时返回 405 供上层区分。
+#include "api_router.h"
+
+namespace api_router {
+namespace {
+
+bool matchPattern(const char* pattern, const char* path, RouteParams& params) {
+  RouteParams captured;
+  while (*pattern != '\0') {
+    if (*pattern == '<') {
+      while (*pattern != '\0' && *pattern != '>') {
+        ++pattern;
+      }
+      if (*pattern == '>') {
+        ++pattern;
+      }
+      const char* segment = path;
+      while (*path != '\0' && *path != '/') {
+        ++path;
+      }
+      if (path == segment) {
+        return false;
+      }
+      captured.value = segment;
+      captured.length = static_cast<size_t>(path - segment);
+      continue;
+    }
+    if (*pattern != *path) {
+      return false;
+    }
+    ++pattern;
+    ++path;
+  }
+  if (*path != '\0') {
+    return false;
+  }
+  params = captured;
+  return true;
+}
+
+}  // namespace
+
+bool RouteParams::toUint(uint32_t& out) const {
+  if (value == nullptr || length == 0 || length > 10) {
+    return false;
+  }
+  uint64_t parsed = 0;
+  for (size_t i = 0; i < length; ++i) {
+    const char ch = value[i];
+    if (ch < '0' || ch > '9') {
+      return false;
+    }
+    parsed = parsed * 10 + static_cast<uint64_t>(ch - '0');
+  }
+  if (parsed > UINT32_MAX) {
+    return false;
+  }
+  out = static_cast<uint32_t>(parsed);
+  return true;
+}
+
+MatchResult match(const Route* routes,
+                  size_t count,
+                  HTTPMethod method,
+                  const char* path,
+                  size_t& index,
+                  RouteParams& params) {
+  MatchResult result = MatchResult::kNotFound;
+  for (size_t i = 0; i < count; ++i) {
+    RouteParams candidate;
+    if (!matchPattern(routes[i].pattern, path, candidate)) {
+      continue;
+    }
+    if (routes[i].method != HTTP_ANY && routes[i].method != method) {
+      result = MatchResult::kMethodNotAllowed;
+      continue;
+    }
+    index = i;
+    params = candidate;
+    return MatchResult::kMatched;
+  }
+  return result;
+}
+
+const char* methodName(HTTPMethod method) {
+  switch (method) {
+    case HTTP_GET:
+      return "GET";
+    case HTTP_POST:
+      return "POST";
+    case HTTP_PUT:
+      return "PUT";
+    case HTTP_PATCH:
+      return "PATCH";
+    case HTTP_DELETE:
+      return "DELETE";
+    case HTTP_OPTIONS:
+      return "OPTIONS";
+    default:
+      return "ANY";
+  }
+}
+
+}  // namespace api_router
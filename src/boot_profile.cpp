@@ -0,0 +1,36 @@
+// 原理说明：以 millis() 为时间基准，固定数组保存各阶段时间戳，开销可以忽略。
+#include "boot_profile.h"
+
+namespace boot_profile {
+namespace {
+
+constexpr const char* kPhaseNames[kPhaseCount] = {
+    "serialReadyMs", "wifiReadyMs", "serverReadyMs", "fsMountedMs", "firstResponseMs",
+};
+
+bool phase_reached[kPhaseCount] = {};
+unsigned long phase_at[kPhaseCount] = {};
+
+}  // namespace
+
+void mark(Phase phase) {
+  if (phase >= kPhaseCount || phase_reached[phase]) {
+    return;
+  }
+  phase_reached[phase] = true;
+  phase_at[phase] = millis();
+}
+
+bool reached(Phase phase) {
+  return phase < kPhaseCount && phase_reached[phase];
+}
+
+unsigned long at(Phase phase) {
+  return reached(phase) ? phase_at[phase] : 0;
+}
+
+const char* phaseName(Phase phase) {
+  return phase < kPhaseCount ? kPhaseNames[phase] : "";
+}
+
+}  // namespace boot_profile
@@ -0,0 +1,121 @@
+// 原理说明：令牌桶按固定间隔补充令牌限制突发；命令下发后到收到 ack 前视为待回执，期间相同命令直接合并到已发送的消息。
+#include "command_limiter.h"
+
+#include <string.h>
+
+namespace command_limiter {
+namespace {
+
+constexpr unsigned long kRefillIntervalMs = 1500;
+constexpr unsigned long kPendingTimeoutMs = 3000;
+
+Counters command_counters;
+
+void refill(TargetState& state, unsigned long now_ms) {
+  if (state.tokens >= kBucketCapacity) {
+    state.refilled_at = now_ms;
+    return;
+  }
+  const unsigned long intervals = (now_ms - state.refilled_at) / kRefillIntervalMs;
+  if (intervals == 0) {
+    return;
+  }
+  const unsigned long tokens = state.tokens + intervals;
+  state.tokens = tokens >= kBucketCapacity ? kBucketCapacity : static_cast<uint8_t>(tokens);
+  state.refilled_at += intervals * kRefillIntervalMs;
+}
+
+}  // namespace
+
+bool parseAction(const char* text, Action& action) {
+  if (text == nullptr) {
+    return false;
+  }
+  if (strcmp(text, "on") == 0) {
+    action = Action::kOn;
+  } else if (strcmp(text, "off") == 0) {
+    action = Action::kOff;
+  } else if (strcmp(text, "pulse") == 0) {
+    action = Action::kPulse;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+Result evaluate(TargetState& state,
+                Action action,
+                uint16_t pulse_ms,
+                int switch_state,
+                unsigned long state_updated_at,
+                unsigned long now_ms) {
+  Result result;
+  if (state.pending && now_ms - state.sent_at >= kPendingTimeoutMs) {
+    state.pending = false;
+  }
+
+  // data 帧周期上报，下发之后到达的帧仍可能是执行命令之前采样的；只有晚于 ack 的快照才反映命令执行后的状态，
+  // 超时未收到 ack 时快照一律不可信。
+  const bool state_fresh =
+      switch_state >= 0 &&
+      (!state.ever_sent ||
+       (state.acked_since_sent && static_cast<long>(state_updated_at - state.acked_at) > 0));
+  if (!state.pending && state_fresh && action != Action::kOff) {
+    if (action == Action::kOn && switch_state > 0) {
+      result.verdict = Verdict::kSuppressed;
+      command_counters.suppressed += 1;
+      return result;
+    }
+  }
+
+  if (state.pending && state.pending_action == action &&
+      (action != Action::kPulse || state.pending_pulse_ms == pulse_ms)) {
+    result.verdict = Verdict::kCoalesced;
+    result.message_id = state.pending_message_id;
+    command_counters.coalesced += 1;
+    return result;
+  }
+
+  // off 不消耗令牌：令牌桶用来防止执行机构被反复开启，关闭永远放行。
+  if (action == Action::kOff) {
+    return result;
+  }
+
+  // 这里只检查令牌，真正扣除放在 markSent()：串口写入失败的命令不消耗令牌。
+  refill(state, now_ms);
+  if (state.tokens == 0) {
+    result.verdict = Verdict::kRateLimited;
+    result.retry_after_ms = kRefillIntervalMs - (now_ms - state.refilled_at);
+    command_counters.rate_limited += 1;
+  }
+  return result;
+}
+
+void markSent(TargetState& state, Action action, uint16_t pulse_ms, uint32_t message_id, unsigned long now_ms) {
+  if (action != Action::kOff) {
+    refill(state, now_ms);
+    if (state.tokens > 0) {
+      state.tokens -= 1;
+    }
+  }
+  state.pending = true;
+  state.pending_action = action;
+  state.pending_pulse_ms = pulse_ms;
+  state.pending_message_id = message_id;
+  state.sent_at = now_ms;
+  state.ever_sent = true;
+  state.acked_since_sent = false;
+  command_counters.sent += 1;
+}
+
+void markAcked(TargetState& state, unsigned long now_ms) {
+  state.pending = false;
+  state.acked_since_sent = true;
+  state.acked_at = now_ms;
+}
+
+const Counters& counters() {
+  return command_counters;
+}
+
+}  // namespace command_limiter
@@ -0,0 +1,70 @@
+// 原理说明：编译期对注册表中的名称做 FNV-1a 哈希并生成槽位索引，static_assert 保证无冲突，运行时一次哈希加一次 strcmp 即可完成查找。
+#include "device_registry.h"
+
+#include <string.h>
+
+namespace device_registry {
+namespace {
+
+constexpr size_t kIndexSlots = 16;
+
+template <size_t Slots>
+struct PerfectIndex {
+  int8_t slot[Slots];
+  bool collision_free;
+};
+
+constexpr uint32_t hashKey(const char* key) {
+  uint32_t hash = 2166136261u;
+  while (*key != '\0') {
+    hash ^= static_cast<uint8_t>(*key++);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+template <size_t Slots, typename Spec, size_t N>
+constexpr PerfectIndex<Slots> buildIndex(const Spec (&table)[N]) {
+  PerfectIndex<Slots> index{};
+  index.collision_free = N <= Slots;
+  for (size_t i = 0; i < Slots; ++i) {
+    index.slot[i] = kNotFound;
+  }
+  for (size_t i = 0; i < N && i < Slots; ++i) {
+    const size_t slot = hashKey(table[i].key) % Slots;
+    if (index.slot[slot] != kNotFound) {
+      index.collision_free = false;
+    }
+    index.slot[slot] = static_cast<int8_t>(i);
+  }
+  return index;
+}
+
+constexpr PerfectIndex<kIndexSlots> kMetricIndex = buildIndex<kIndexSlots>(kMetrics);
+constexpr PerfectIndex<kIndexSlots> kActuatorIndex = buildIndex<kIndexSlots>(kActuators);
+static_assert(kMetricIndex.collision_free, "metric key hash collision, enlarge kIndexSlots");
+static_assert(kActuatorIndex.collision_free, "actuator key hash collision, enlarge kIndexSlots");
+
+template <size_t Slots, typename Spec, size_t N>
+int lookup(const PerfectIndex<Slots>& index, const Spec (&table)[N], const char* key) {
+  if (key == nullptr) {
+    return kNotFound;
+  }
+  const int slot = index.slot[hashKey(key) % Slots];
+  if (slot == kNotFound || strcmp(table[slot].key, key) != 0) {
+    return kNotFound;
+  }
+  return slot;
+}
+
+}  // namespace
+
+int findMetric(const char* key) {
+  return lookup(kMetricIndex, kMetrics, key);
+}
+
+int findActuator(const char* key) {
+  return lookup(kActuatorIndex, kActuators, key);
+}
+
+}  // namespace device_registry
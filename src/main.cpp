@@ -1,7 +1,9 @@
 // 原理说明：主程序负责初始化各模块、周期性维护 Wi-Fi 与串口通信状态，并驱动 Web 服务器与协议中转逻辑。
 #include <Arduino.h>
 
+#include "boot_profile.h"
 #include "device_config.h"
+#include "power_manager.h"
 #include "serial_bridge.h"
 #include "web_server_module.h"
 #include "wifi_manager.h"
@@ -12,6 +14,7 @@ constexpr uint32_t kApRetryIntervalMs = 5000;
 unsigned long lastReconnectAttempt = 0;
 bool lastWifiConnected = false;
 IPAddress lastIpReported(0, 0, 0, 0);
+uint32_t lastUartBytes = 0;
 
 IPAddress currentStatusIp() {
   if (wifi_manager::isConnected()) {
@@ -29,6 +32,16 @@ void reportNetworkStatusIfChanged() {
   }
 }
 
+void applyPowerMode(power_manager::Mode mode) {
+  wifi_manager::setLowPower(mode == power_manager::Mode::kIdle);
+
+  // 通知 STM32 调整上报周期，无人查看时降低上报频率。
+  StaticJsonDocument<64> doc;
+  doc["type"] = "cfg";
+  doc["report"] = power_manager::reportIntervalSeconds(mode);
+  serial_bridge::sendJson(doc);
+}
+
 }  // namespace
 
 void setup() {
@@ -36,9 +49,16 @@ void setup() {
   // Serial.println();
   // Serial.println(F("智能盆栽通信终端启动中..."));
 
+  // 先挂上消息处理器：数据帧只写入内存快照，不依赖 Wi-Fi 或 Web 服务，
+  // 启动期间 STM32 上报的帧因此不会丢失，网页首次打开即可看到。
   serial_bridge::setMessageHandler(web_server_module::handleSerialLine);
+  boot_profile::mark(boot_profile::kSerialReady);
 
-  wifi_manager::startAccessPoint(device_config::WIFI_SSID, device_config::WIFI_PASSWORD);
+  if (!wifi_manager::resumeAccessPoint(device_config::WIFI_SSID, device_config::WIFI_PASSWORD)) {
+    wifi_manager::startAccessPoint(device_config::WIFI_SSID, device_config::WIFI_PASSWORD);
+  }
+  boot_profile::mark(boot_profile::kWifiReady);
+  serial_bridge::loop();
   if (wifi_manager::isConnected()) {
     // Serial.print(F("Wi-Fi 热点已创建，SSID: "));
     // Serial.println(device_config::WIFI_SSID);
@@ -49,12 +69,18 @@ void setup() {
   }
 
   web_server_module::start(device_config::WEB_SERVER_PORT);
+  boot_profile::mark(boot_profile::kServerReady);
+  serial_bridge::loop();
   // Serial.println(F("Web 服务已启动。"));
 
   reportNetworkStatusIfChanged();
+
+  power_manager::begin(millis());
+  applyPowerMode(power_manager::mode());
 }
 
 void loop() {
+  const unsigned long loopStartedUs = micros();
   serial_bridge::loop();
   web_server_module::loop();
 
@@ -68,5 +94,15 @@ void loop() {
     }
   }
 
-  delay(10);
+  const uint32_t uartBytes = serial_bridge::stats().bytes_received;
+  const power_manager::Decision decision =
+      power_manager::update(millis(), wifi_manager::stationCount(), uartBytes != lastUartBytes);
+  lastUartBytes = uartBytes;
+  if (decision.mode_changed) {
+    applyPowerMode(decision.mode);
+  }
+
+  const unsigned long sleepStartedUs = micros();
+  delay(decision.poll_delay_ms);
+  power_manager::recordLoop(sleepStartedUs - loopStartedUs, micros() - sleepStartedUs);
 }
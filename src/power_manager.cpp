@@ -0,0 +1,86 @@
+// 原理说明：无客户端持续一段时间后进入空闲模式并加长轮询间隔；串口有数据时短暂恢复快速轮询，保证整行及时读出。
+#include "power_manager.h"
+
+namespace power_manager {
+namespace {
+
+constexpr uint16_t kActivePollMs = 10;
+constexpr uint16_t kIdlePollMs = 50;
+constexpr unsigned long kIdleEnterDelayMs = 30000;
+constexpr unsigned long kUartWakeHoldMs = 200;
+constexpr uint16_t kActiveReportSeconds = 5;
+constexpr uint16_t kIdleReportSeconds = 30;
+constexpr uint32_t kDutyWindowUs = 10UL * 1000UL * 1000UL;
+
+Mode current_mode = Mode::kActive;
+unsigned long last_client_seen_ms = 0;
+unsigned long last_uart_activity_ms = 0;
+bool uart_wake_pending = false;
+uint32_t window_busy_us = 0;
+uint32_t window_total_us = 0;
+float last_duty_cycle = 1.0f;
+
+}  // namespace
+
+void begin(unsigned long now_ms) {
+  current_mode = Mode::kActive;
+  last_client_seen_ms = now_ms;
+  last_uart_activity_ms = now_ms;
+  uart_wake_pending = false;
+  window_busy_us = 0;
+  window_total_us = 0;
+  last_duty_cycle = 1.0f;
+}
+
+Decision update(unsigned long now_ms, uint8_t station_count, bool uart_activity) {
+  if (station_count > 0) {
+    last_client_seen_ms = now_ms;
+  }
+  if (uart_activity) {
+    last_uart_activity_ms = now_ms;
+    uart_wake_pending = true;
+  }
+
+  const Mode next_mode = now_ms - last_client_seen_ms >= kIdleEnterDelayMs ? Mode::kIdle : Mode::kActive;
+
+  Decision decision;
+  decision.mode = next_mode;
+  decision.mode_changed = next_mode != current_mode;
+  current_mode = next_mode;
+
+  if (uart_wake_pending && now_ms - last_uart_activity_ms >= kUartWakeHoldMs) {
+    uart_wake_pending = false;
+  }
+  const bool fast_poll = current_mode == Mode::kActive || uart_wake_pending;
+  decision.poll_delay_ms = fast_poll ? kActivePollMs : kIdlePollMs;
+  return decision;
+}
+
+void recordLoop(uint32_t busy_us, uint32_t sleep_us) {
+  window_busy_us += busy_us;
+  window_total_us += busy_us + sleep_us;
+  if (window_total_us < kDutyWindowUs) {
+    return;
+  }
+  last_duty_cycle = static_cast<float>(window_busy_us) / static_cast<float>(window_total_us);
+  window_busy_us = 0;
+  window_total_us = 0;
+}
+
+Mode mode() {
+  return current_mode;
+}
+
+const char* modeName(Mode mode) {
+  return mode == Mode::kIdle ? "idle" : "active";
+}
+
+uint16_t reportIntervalSeconds(Mode mode) {
+  return mode == Mode::kIdle ? kIdleReportSeconds : kActiveReportSeconds;
+}
+
+float dutyCycle() {
+  return last_duty_cycle;
+}
+
+}  // namespace power_manager
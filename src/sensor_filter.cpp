@@ -0,0 +1,67 @@
+// 原理说明：中值窗口剔除单点尖峰，变化率限制约束剩余的阶跃，指数平滑去除抖动；每个指标只保存最近 N 个原始值与上一次输出。
+#include "sensor_filter.h"
+
+#include <math.h>
+
+namespace sensor_filter {
+namespace {
+
+float medianOf(const FilterState& state) {
+  float sorted[kMaxMedianWindow];
+  for (uint8_t i = 0; i < state.filled; ++i) {
+    float value = state.window[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > value) {
+      sorted[j] = sorted[j - 1];
+      --j;
+    }
+    sorted[j] = value;
+  }
+  if ((state.filled & 1) != 0) {
+    return sorted[state.filled / 2];
+  }
+  return (sorted[state.filled / 2 - 1] + sorted[state.filled / 2]) * 0.5f;
+}
+
+}  // namespace
+
+float apply(FilterState& state, const FilterSpec& spec, float raw, unsigned long now_ms) {
+  if (isnan(raw)) {
+    return raw;
+  }
+
+  uint8_t window = spec.median_window;
+  if (window < 1) {
+    window = 1;
+  } else if (window > kMaxMedianWindow) {
+    window = kMaxMedianWindow;
+  }
+  state.window[state.next] = raw;
+  state.next = (state.next + 1) % window;
+  if (state.filled < window) {
+    state.filled += 1;
+  }
+  float value = medianOf(state);
+
+  if (!state.has_output) {
+    state.has_output = true;
+    state.output = value;
+    state.updated_at = now_ms;
+    return state.output;
+  }
+
+  if (spec.max_rate_per_s > 0.0f) {
+    const float max_step = spec.max_rate_per_s * (now_ms - state.updated_at) / 1000.0f;
+    if (value > state.output + max_step) {
+      value = state.output + max_step;
+    } else if (value < state.output - max_step) {
+      value = state.output - max_step;
+    }
+  }
+
+  state.output += spec.ema_alpha * (value - state.output);
+  state.updated_at = now_ms;
+  return state.output;
+}
+
+}  // namespace sensor_filter
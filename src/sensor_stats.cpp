@@ -0,0 +1,137 @@
+// 原理说明：每个窗口由固定数量的时间分桶组成，桶内用 Welford 算法累计均值与方差，查询时按 Chan 公式合并，内存占用与样本数无关。
+#include "sensor_stats.h"
+
+#include <math.h>
+
+namespace sensor_stats {
+namespace {
+
+struct WindowSpec {
+  const char* name;
+  uint32_t bucket_ms;
+  uint8_t bucket_count;
+};
+
+constexpr WindowSpec kWindows[kWindowCount] = {
+    {"1h", 10UL * 60UL * 1000UL, kHourBuckets},
+    {"24h", 2UL * 60UL * 60UL * 1000UL, kDayBuckets},
+};
+// 两次采样间隔过长（如 STM32 掉线）时不再把整段间隔计入超限时长。
+constexpr unsigned long kMaxSampleGapMs = 30000;
+
+// 分桶序号只保留低 16 位，按无符号差值判断是否仍在窗口内。
+uint16_t epochOf(const WindowSpec& spec, unsigned long now_ms) {
+  return static_cast<uint16_t>(now_ms / spec.bucket_ms);
+}
+
+Bucket* bucketsFor(MetricStats& stats, Window window) {
+  return window == kWindowHour ? stats.hour : stats.day;
+}
+
+const Bucket* bucketsFor(const MetricStats& stats, Window window) {
+  return window == kWindowHour ? stats.hour : stats.day;
+}
+
+Bucket& currentBucket(MetricStats& stats, Window window, unsigned long now_ms) {
+  const WindowSpec& spec = kWindows[window];
+  const uint32_t sequence = now_ms / spec.bucket_ms;
+  Bucket& bucket = bucketsFor(stats, window)[sequence % spec.bucket_count];
+  const uint16_t epoch = epochOf(spec, now_ms);
+  if (bucket.count == 0 || bucket.epoch != epoch) {
+    bucket = Bucket();
+    bucket.epoch = epoch;
+  }
+  return bucket;
+}
+
+void addSample(Bucket& bucket, float value, uint32_t above_ms) {
+  bucket.above_ms += above_ms;
+  if (bucket.count == 0) {
+    bucket.count = 1;
+    bucket.mean = value;
+    bucket.m2 = 0.0f;
+    bucket.min = value;
+    bucket.max = value;
+    return;
+  }
+  if (bucket.count == UINT16_MAX) {
+    return;
+  }
+  bucket.count += 1;
+  const float delta = value - bucket.mean;
+  bucket.mean += delta / bucket.count;
+  bucket.m2 += delta * (value - bucket.mean);
+  if (value < bucket.min) {
+    bucket.min = value;
+  }
+  if (value > bucket.max) {
+    bucket.max = value;
+  }
+}
+
+}  // namespace
+
+void record(MetricStats& stats, float value, bool threshold_enabled, float threshold, unsigned long now_ms) {
+  if (isnan(value)) {
+    return;
+  }
+
+  uint32_t above_ms = 0;
+  if (stats.has_last && stats.last_above) {
+    const unsigned long gap = now_ms - stats.last_at;
+    above_ms = gap > kMaxSampleGapMs ? kMaxSampleGapMs : gap;
+  }
+  stats.has_last = true;
+  stats.last_above = threshold_enabled && value > threshold;
+  stats.last_at = now_ms;
+
+  for (uint8_t w = 0; w < kWindowCount; ++w) {
+    addSample(currentBucket(stats, static_cast<Window>(w), now_ms), value, above_ms);
+  }
+}
+
+bool summarize(const MetricStats& stats, Window window, unsigned long now_ms, Summary& out) {
+  out = Summary();
+  if (window >= kWindowCount) {
+    return false;
+  }
+
+  const WindowSpec& spec = kWindows[window];
+  const uint16_t current_epoch = epochOf(spec, now_ms);
+  const Bucket* buckets = bucketsFor(stats, window);
+
+  double mean = 0.0;
+  double m2 = 0.0;
+  for (uint8_t i = 0; i < spec.bucket_count; ++i) {
+    const Bucket& bucket = buckets[i];
+    if (bucket.count == 0 || static_cast<uint16_t>(current_epoch - bucket.epoch) >= spec.bucket_count) {
+      continue;
+    }
+    if (out.count == 0) {
+      out.min = bucket.min;
+      out.max = bucket.max;
+    } else {
+      out.min = bucket.min < out.min ? bucket.min : out.min;
+      out.max = bucket.max > out.max ? bucket.max : out.max;
+    }
+    const double total = static_cast<double>(out.count) + bucket.count;
+    const double delta = bucket.mean - mean;
+    mean += delta * bucket.count / total;
+    m2 += bucket.m2 + delta * delta * out.count * bucket.count / total;
+    out.count += bucket.count;
+    out.above_ms += bucket.above_ms;
+  }
+
+  if (out.count == 0) {
+    return false;
+  }
+  out.mean = static_cast<float>(mean);
+  out.stddev = out.count > 1 ? static_cast<float>(sqrt(m2 / (out.count - 1))) : 0.0f;
+  return true;
+}
+
+const char* windowName(Window window) {
+  return window < kWindowCount ? kWindows[window].name : "";
+}
+
+}  // namespace sensor_stats
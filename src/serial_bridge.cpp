@@ -6,54 +6,111 @@
 namespace serial_bridge {
 namespace {
 
+constexpr size_t kMaxLineLength = 512;
+constexpr size_t kReadChunkSize = 64;
+// 启动阶段只在各步骤之间调用 loop() 读取串口，WiFi.mode()/softAP() 等阻塞调用期间无人读取，数据只能积压在接收缓冲里。
+// 115200 波特约 11.5 KB/s，1 KiB 只能容纳约 89 ms 的连续数据，并不覆盖整个热点建立过程；
+// 它能兜住的是 STM32 按周期上报的零星帧（data 帧约 100 字节，缓冲可积压 10 帧左右）。
+constexpr size_t kRxBufferSize = 1024;
+
 HardwareSerial* port = nullptr;
 MessageHandler message_handler = nullptr;
 String rx_buffer;
+bool discarding_line = false;
+LinkStats link_stats;
 
 void dispatchBuffer() {
+  if (discarding_line) {
+    // 超长行在遇到换行符时才算结束，整行计为丢弃。
+    discarding_line = false;
+    link_stats.frames_dropped += 1;
+    return;
+  }
   if (rx_buffer.length() == 0) {
     return;
   }
+  if (rx_buffer.length() > link_stats.longest_line) {
+    link_stats.longest_line = static_cast<uint16_t>(rx_buffer.length());
+  }
+  link_stats.frames_delivered += 1;
   if (message_handler != nullptr) {
     message_handler(rx_buffer);
   }
   rx_buffer = "";
 }
 
+void appendSegment(const char* data, size_t length) {
+  if (length == 0 || discarding_line) {
+    return;
+  }
+  if (rx_buffer.length() + length > kMaxLineLength) {
+    // 缓冲区溢出时丢弃整行直至下一个换行符，避免把残余片段当作新帧转发。
+    rx_buffer = "";
+    discarding_line = true;
+    return;
+  }
+  rx_buffer.concat(data, length);
+}
+
 }  // namespace
 
 void begin(HardwareSerial& serial_port, unsigned long baud_rate) {
   port = &serial_port;
+  // 必须在 begin() 之前设置，否则 SDK 会先按默认 256 字节分配一次。
+  port->setRxBufferSize(kRxBufferSize);
   port->begin(baud_rate);
-  rx_buffer.reserve(256);
+  // 预留整行容量，逐段追加时不会反复扩容。
+  rx_buffer.reserve(kMaxLineLength);
 }
 
 void setMessageHandler(MessageHandler handler) {
   message_handler = handler;
 }
 
+void feedBytes(const char* data, size_t length) {
+  link_stats.bytes_received += length;
+
+  size_t segment_start = 0;
+  for (size_t i = 0; i < length; ++i) {
+    const char ch = data[i];
+    if (ch != '\n' && ch != '\r') {
+      continue;
+    }
+    appendSegment(data + segment_start, i - segment_start);
+    if (ch == '\n') {
+      dispatchBuffer();
+    }
+    segment_start = i + 1;
+  }
+  appendSegment(data + segment_start, length - segment_start);
+}
+
 void loop() {
   if (port == nullptr) {
     return;
   }
 
-  while (port->available() > 0) {
-    const char ch = static_cast<char>(port->read());
-    if (ch == '\n') {
-      dispatchBuffer();
-    } else if (ch == '\r') {
-      continue;
-    } else {
-      if (rx_buffer.length() < 512) {
-        rx_buffer += ch;
-      } else {
-        // 缓冲区溢出时丢弃当前行，避免占用过多内存。
-        rx_buffer = "";
-      }
+  if (port->hasOverrun()) {
+    link_stats.rx_overruns += 1;
+  }
+
+  char chunk[kReadChunkSize];
+  int available = port->available();
+  while (available > 0) {
+    const size_t wanted = static_cast<size_t>(available) < sizeof(chunk) ? static_cast<size_t>(available) : sizeof(chunk);
+    const size_t received = port->read(chunk, wanted);
+    if (received == 0) {
+      break;
     }
+    feedBytes(chunk, received);
+    available = port->available();
   }
 }
 
+const LinkStats& stats() {
+  return link_stats;
+}
+
 bool sendJson(const JsonDocument& doc) {
   if (port == nullptr) {
     return false;
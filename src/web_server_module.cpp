@@ -1,4 +1,4 @@
-// 原理说明：Web 服务模块通过 ESP8266WebServer 提供静态资源与 REST 接口，并维护消息缓冲，实现网页与 STM32 间的 NDJSON 中转。
+// 原理说明：Web 服务模块通过 ESP8266WebServer 提供静态资源与 REST 接口，并维护消息缓冲，实现网页与 STM32 间的 NDJSON 中转；网关模式下按节点号分别保存各盆栽的状态。
 #include "web_server_module.h"
 
 #include <Arduino.h>
@@ -8,24 +8,32 @@
 #include <LittleFS.h>
 #include <math.h>
 
-#include <vector>
+#include <new>
 
+#include "api_router.h"
+#include "boot_profile.h"
+#include "command_limiter.h"
+#include "device_registry.h"
+#include "power_manager.h"
+#include "sensor_filter.h"
+#include "sensor_stats.h"
 #include "serial_bridge.h"
 #include "wifi_manager.h"
 
 namespace web_server_module {
 namespace {
 
+using device_registry::kActuatorCount;
+using device_registry::kActuators;
+using device_registry::kMetricCount;
+using device_registry::kMetrics;
+
+// 指标与开关状态按注册表下标存放，顺序与 device_registry 中的表一致；metrics 为滤波后的值，raw 为原始值。
 struct SensorSnapshot {
   bool valid = false;
-  float temp = 0.0f;
-  float humi = 0.0f;
-  int soil = 0;
-  float lux = 0.0f;
-  uint8_t water = 0;
-  uint8_t light = 0;
-  uint8_t fan = 0;
-  uint8_t buzzer = 0;
+  float metrics[kMetricCount] = {};
+  float raw[kMetricCount] = {};
+  uint8_t switches[kActuatorCount] = {};
   unsigned long updated_at = 0;
 };
 
@@ -43,36 +51,87 @@ struct NumericThreshold {
 };
 
 struct ThresholdConfig {
-  NumericThreshold temp;
-  NumericThreshold humi;
-  NumericThreshold soil;
-  NumericThreshold lux;
+  NumericThreshold metrics[kMetricCount];
 };
 
 struct AlarmState {
   unsigned long lastTriggeredAt = 0;
   String reason;
   uint32_t count = 0;
+  unsigned long lastCommandMs = 0;
+};
+
+struct ParsedCommand {
+  size_t target = 0;
+  command_limiter::Action action = command_limiter::Action::kOff;
+  uint16_t pulse_ms = 0;
+};
+
+enum MessageType : uint8_t {
+  kMessageData = 0,
+  kMessageAck,
+  kMessageCmd,
+  kMessageAlarm,
+  kMessageStatus,
+  kMessageOther,
+  kMessageTypeCount,
+};
+
+constexpr const char* kMessageTypeNames[kMessageTypeCount] = {"data", "ack", "cmd", "alarm", "status", "other"};
+
+// 节点号即节点表下标；帧内 node 字段缺省为 0，兼容单节点部署。
+constexpr uint8_t kMaxNodes = 8;
+constexpr uint8_t kNoNode = 0xFF;
+
+// 每个节点一份运行状态，首次出现时按需分配，单盆栽部署只占用一份内存。
+struct NodeState {
+  bool seen = false;
+  SensorSnapshot sensor;
+  AckSnapshot ack;
+  ThresholdConfig thresholds;
+  AlarmState alarm;
+  String reported_ip = "0.0.0.0";
+  sensor_filter::FilterState filters[kMetricCount];
+  sensor_stats::MetricStats stats[kMetricCount];
+  command_limiter::TargetState commands[kActuatorCount];
+};
+
+// 消息在日志中的位置，槽位中的编号不符说明该条已被淘汰。
+struct MessageRef {
+  uint32_t id = 0;
+  uint8_t slot = 0;
 };
 
+// 日志条目；同一来源（节点或无节点）同类型的消息通过 prev_same_type 串成链表，按类型或节点过滤时只需遍历命中的条目。
 struct MessageEntry {
   uint32_t id = 0;
+  MessageRef prev_same_type;
+  MessageType type = kMessageOther;
+  uint8_t node = kNoNode;
   String payload;
 };
 
+// 每个来源一份链表头与条目数；下标 kMaxNodes 归 node 缺失或非法的帧。
+struct MessageSource {
+  MessageRef last_of_type[kMessageTypeCount];
+  uint8_t count = 0;
+};
+constexpr uint8_t kMessageSourceCount = kMaxNodes + 1;
+
 ESP8266WebServer* server = nullptr;
 bool littleFsMounted = false;
-SensorSnapshot latest_sensor;
-AckSnapshot last_ack;
-ThresholdConfig threshold_config;
-AlarmState alarm_state;
-std::vector<MessageEntry> message_log;
+bool littleFsMountAttempted = false;
+NodeState* nodes[kMaxNodes] = {};
+// 各节点共享 48 个槽位，但每个节点保留最近 4 条：一个节点高频上报 data 时只会挤掉自己或无节点的旧消息，
+// 其他节点的 ack 与 alarm 不会在几十秒内被冲掉。
+constexpr size_t kMaxMessages = 48;
+constexpr uint8_t kReservedMessagesPerNode = 4;
+static_assert(kMaxNodes * kReservedMessagesPerNode < kMaxMessages, "保留份额必须小于日志容量");
+MessageEntry message_log[kMaxMessages];
+MessageSource message_sources[kMessageSourceCount];
 uint32_t last_message_id = 0;
-constexpr size_t kMaxMessages = 32;
 constexpr unsigned long kAlarmCooldownMs = 15000;
 constexpr uint16_t kAlarmPulseMs = 3000;
-unsigned long lastAlarmCommandMs = 0;
-String last_reported_ip("0.0.0.0");
 
 String buildFallbackPage() {
   String html;
@@ -94,22 +153,132 @@ String buildFallbackPage() {
   return html;
 }
 
-void addMessage(const String& line) {
-  MessageEntry entry;
+NodeState* findNode(uint8_t node_id) {
+  return node_id < kMaxNodes ? nodes[node_id] : nullptr;
+}
+
+NodeState* ensureNode(uint8_t node_id) {
+  if (node_id >= kMaxNodes) {
+    return nullptr;
+  }
+  if (nodes[node_id] == nullptr) {
+    nodes[node_id] = new (std::nothrow) NodeState();
+  }
+  return nodes[node_id];
+}
+
+// 解析请求中的 node 参数（缺省为 0）；非法时已向客户端返回 400。
+bool parseRequestNode(const String& raw, uint8_t& node_id) {
+  node_id = 0;
+  if (raw.length() > 0) {
+    const long parsed = raw.toInt();
+    if (parsed < 0 || parsed >= kMaxNodes || (parsed == 0 && raw != "0")) {
+      server->send(400, "application/json", F("{\"error\":\"node 非法\"}"));
+      return false;
+    }
+    node_id = static_cast<uint8_t>(parsed);
+  }
+  return true;
+}
+
+// 只读接口只查找已有节点，任意 ?node= 探测都不会占用节点表内存；未知节点返回 404。
+bool findRequestNode(uint8_t& node_id, NodeState*& node) {
+  if (!parseRequestNode(server->arg("node"), node_id)) {
+    return false;
+  }
+  node = findNode(node_id);
+  if (node == nullptr) {
+    server->send(404, "application/json", F("{\"error\":\"节点不存在\"}"));
+    return false;
+  }
+  return true;
+}
+
+MessageType classifyMessage(const char* type) {
+  if (type == nullptr) {
+    return kMessageOther;
+  }
+  for (uint8_t i = 0; i < kMessageOther; ++i) {
+    if (strcmp(type, kMessageTypeNames[i]) == 0) {
+      return static_cast<MessageType>(i);
+    }
+  }
+  return kMessageOther;
+}
+
+uint8_t messageSourceIndex(uint8_t node_id) {
+  return node_id < kMaxNodes ? node_id : kMaxNodes;
+}
+
+const MessageEntry* resolveMessage(const MessageRef& ref) {
+  if (ref.id == 0) {
+    return nullptr;
+  }
+  const MessageEntry& entry = message_log[ref.slot];
+  return entry.id == ref.id ? &entry : nullptr;
+}
+
+// 按编号查找需扫描全部槽位，仅 /api/messages/<id> 使用；链表遍历走 resolveMessage。
+const MessageEntry* findMessage(uint32_t id) {
+  if (id == 0) {
+    return nullptr;
+  }
+  for (const MessageEntry& entry : message_log) {
+    if (entry.id == id) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+// 优先使用空槽，否则淘汰可淘汰来源中最旧的一条：无节点消息、新消息自己的来源，或条目数超出保留份额的节点。
+// 可否淘汰只取决于来源，被淘汰的总是该来源最旧的条目，同来源链表只会从尾部截断。
+size_t selectMessageSlot(uint8_t source_index) {
+  size_t victim = kMaxMessages;
+  for (size_t i = 0; i < kMaxMessages; ++i) {
+    const MessageEntry& entry = message_log[i];
+    if (entry.id == 0) {
+      return i;
+    }
+    const uint8_t owner = messageSourceIndex(entry.node);
+    const bool evictable = owner == kMaxNodes || owner == source_index ||
+                           message_sources[owner].count > kReservedMessagesPerNode;
+    if (evictable && (victim == kMaxMessages || entry.id < message_log[victim].id)) {
+      victim = i;
+    }
+  }
+  return victim;
+}
+
+void addMessage(const String& line, MessageType type, uint8_t node_id) {
+  const uint8_t source_index = messageSourceIndex(node_id);
+  const size_t slot = selectMessageSlot(source_index);
+  MessageEntry& entry = message_log[slot];
+  if (entry.id != 0) {
+    message_sources[messageSourceIndex(entry.node)].count -= 1;
+  }
+
+  MessageSource& source = message_sources[source_index];
   entry.id = ++last_message_id;
+  entry.type = type;
+  entry.node = node_id;
+  entry.prev_same_type = source.last_of_type[type];
   entry.payload = line;
-  message_log.push_back(entry);
-  if (message_log.size() > kMaxMessages) {
-    message_log.erase(message_log.begin());
-  }
+  source.last_of_type[type].id = entry.id;
+  source.last_of_type[type].slot = static_cast<uint8_t>(slot);
+  source.count += 1;
 }
 
-bool anyThresholdEnabled() {
-  return threshold_config.temp.enabled || threshold_config.humi.enabled ||
-         threshold_config.soil.enabled || threshold_config.lux.enabled;
+bool anyThresholdEnabled(const ThresholdConfig& threshold_config) {
+  for (const auto& threshold : threshold_config.metrics) {
+    if (threshold.enabled) {
+      return true;
+    }
+  }
+  return false;
 }
 
-void appendExceedReason(String& reason, const __FlashStringHelper* label, float value, float limit, uint8_t decimals) {
+void appendExceedReason(String& reason, const char* label, float value, float limit, uint8_t decimals) {
   if (reason.length() > 0) {
     reason += F("；");
   }
@@ -120,22 +289,18 @@ void appendExceedReason(String& reason, const __FlashStringHelper* label, float
   reason += String(limit, decimals);
 }
 
-void fillThresholdJson(JsonObject object) {
-  auto assignThreshold = [&](const char* key, const NumericThreshold& threshold) {
+void fillThresholdJson(JsonObject object, const ThresholdConfig& threshold_config) {
+  for (size_t i = 0; i < kMetricCount; ++i) {
+    const NumericThreshold& threshold = threshold_config.metrics[i];
     if (threshold.enabled) {
-      object[key] = threshold.value;
+      object[kMetrics[i].key] = threshold.value;
     } else {
-      object[key] = nullptr;
+      object[kMetrics[i].key] = nullptr;
     }
-  };
-
-  assignThreshold("temp", threshold_config.temp);
-  assignThreshold("humi", threshold_config.humi);
-  assignThreshold("soil", threshold_config.soil);
-  assignThreshold("lux", threshold_config.lux);
+  }
 }
 
-void fillAlarmJson(JsonObject object) {
+void fillAlarmJson(JsonObject object, const AlarmState& alarm_state) {
   object["count"] = alarm_state.count;
   object["cooldownMs"] = kAlarmCooldownMs;
   object["pulseMs"] = kAlarmPulseMs;
@@ -148,6 +313,22 @@ void fillAlarmJson(JsonObject object) {
   }
 }
 
+// 各响应文档的容量按注册表长度推算，注册表新增一行时容量随之增长；键名与 const char* 取值不占字符串池，
+// String 取值按实际长度另计。
+constexpr size_t kAlarmJsonSize = JSON_OBJECT_SIZE(5);
+constexpr size_t kThresholdDocSize = JSON_OBJECT_SIZE(4) + JSON_OBJECT_SIZE(kMetricCount) + kAlarmJsonSize;
+
+// 容量推算遗漏字段时返回 500，而不是发送被截断的 JSON。
+void sendJsonDocument(const JsonDocument& doc) {
+  if (doc.overflowed()) {
+    server->send(500, "application/json", F("{\"error\":\"响应文档容量不足\"}"));
+    return;
+  }
+  String response;
+  serializeJson(doc, response);
+  server->send(200, "application/json", response);
+}
+
 bool isNumericVariant(const JsonVariantConst& value) {
   return value.is<int>() || value.is<long>() || value.is<unsigned int>() || value.is<unsigned long>() ||
          value.is<float>() || value.is<double>();
@@ -180,55 +361,30 @@ bool updateThresholdValue(const char* key,
   return true;
 }
 
-void checkAndTriggerAlarm(const JsonDocument& doc) {
-  if (!anyThresholdEnabled()) {
+void checkAndTriggerAlarm(uint8_t node_id, NodeState& node, const JsonDocument& doc) {
+  const ThresholdConfig& threshold_config = node.thresholds;
+  AlarmState& alarm_state = node.alarm;
+  if (!anyThresholdEnabled(threshold_config)) {
     return;
   }
 
   bool triggered = false;
   String reason;
 
-  if (threshold_config.temp.enabled) {
-    JsonVariantConst tempVar = doc["temp"];
-    if (!tempVar.isNull()) {
-      const float value = tempVar.as<float>();
-      if (!isnan(value) && value > threshold_config.temp.value) {
-        appendExceedReason(reason, F("温度"), value, threshold_config.temp.value, 1);
-        triggered = true;
-      }
+  for (size_t i = 0; i < kMetricCount; ++i) {
+    const NumericThreshold& threshold = threshold_config.metrics[i];
+    if (!threshold.enabled) {
+      continue;
     }
-  }
-
-  if (threshold_config.humi.enabled) {
-    JsonVariantConst humiVar = doc["humi"];
-    if (!humiVar.isNull()) {
-      const float value = humiVar.as<float>();
-      if (!isnan(value) && value > threshold_config.humi.value) {
-        appendExceedReason(reason, F("湿度"), value, threshold_config.humi.value, 1);
-        triggered = true;
-      }
+    // 仅评估本帧携带的指标，数值取滤波后的快照，避免单点噪声触发报警。
+    JsonVariantConst metricVar = doc[kMetrics[i].key];
+    if (metricVar.isNull() || !isNumericVariant(metricVar)) {
+      continue;
     }
-  }
-
-  if (threshold_config.soil.enabled) {
-    JsonVariantConst soilVar = doc["soil"];
-    if (!soilVar.isNull()) {
-      const float value = soilVar.as<float>();
-      if (!isnan(value) && value > threshold_config.soil.value) {
-        appendExceedReason(reason, F("土壤"), value, threshold_config.soil.value, 0);
-        triggered = true;
-      }
-    }
-  }
-
-  if (threshold_config.lux.enabled) {
-    JsonVariantConst luxVar = doc["lux"];
-    if (!luxVar.isNull()) {
-      const float value = luxVar.as<float>();
-      if (!isnan(value) && value > threshold_config.lux.value) {
-        appendExceedReason(reason, F("光照"), value, threshold_config.lux.value, 1);
-        triggered = true;
-      }
+    const float value = node.sensor.metrics[i];
+    if (!isnan(value) && value > threshold.value) {
+      appendExceedReason(reason, kMetrics[i].label, value, threshold.value, kMetrics[i].decimals);
+      triggered = true;
     }
   }
 
@@ -240,12 +396,13 @@ void checkAndTriggerAlarm(const JsonDocument& doc) {
   alarm_state.reason = reason;
   alarm_state.lastTriggeredAt = now;
 
-  if (now - lastAlarmCommandMs < kAlarmCooldownMs) {
+  if (now - alarm_state.lastCommandMs < kAlarmCooldownMs) {
     return;
   }
 
   StaticJsonDocument<128> cmdDoc;
   cmdDoc["type"] = "cmd";
+  cmdDoc["node"] = node_id;
   cmdDoc["target"] = "buzzer";
   cmdDoc["action"] = "pulse";
   cmdDoc["time"] = kAlarmPulseMs;
@@ -257,40 +414,41 @@ void checkAndTriggerAlarm(const JsonDocument& doc) {
     return;
   }
 
-  addMessage(cmdLine);
+  addMessage(cmdLine, kMessageCmd, node_id);
   const uint32_t commandMessageId = last_message_id;
 
-  StaticJsonDocument<192> logDoc;
+  DynamicJsonDocument logDoc(JSON_OBJECT_SIZE(5) + JSON_STRING_SIZE(reason.length()));
   logDoc["type"] = "alarm";
+  logDoc["node"] = node_id;
   logDoc["reason"] = reason;
   logDoc["triggeredAt"] = now;
   logDoc["relatedMessageId"] = commandMessageId;
   String logLine;
   serializeJson(logDoc, logLine);
-  addMessage(logLine);
+  addMessage(logLine, kMessageAlarm, node_id);
 
-  lastAlarmCommandMs = now;
+  alarm_state.lastCommandMs = now;
   alarm_state.count += 1;
 }
 
-void handleThresholdGet() {
-  if (!server) {
+void handleThresholdGet(const api_router::RouteParams&) {
+  uint8_t node_id = 0;
+  NodeState* node = nullptr;
+  if (!findRequestNode(node_id, node)) {
     return;
   }
 
-  StaticJsonDocument<256> doc;
+  DynamicJsonDocument doc(kThresholdDocSize + JSON_STRING_SIZE(node->alarm.reason.length()));
   doc["ok"] = true;
-  fillThresholdJson(doc.createNestedObject("thresholds"));
-  fillAlarmJson(doc.createNestedObject("alarm"));
-
-  String response;
-  serializeJson(doc, response);
-  server->sendHeader(F("Cache-Control"), F("no-store"));
-  server->send(200, "application/json", response);
+  doc["node"] = node_id;
+  fillThresholdJson(doc.createNestedObject("thresholds"), node->thresholds);
+  fillAlarmJson(doc.createNestedObject("alarm"), node->alarm);
+  sendJsonDocument(doc);
 }
 
-void handleThresholdPost() {
-  if (!server) {
+void handleThresholdPost(const api_router::RouteParams&) {
+  uint8_t node_id = 0;
+  if (!parseRequestNode(server->arg("node"), node_id)) {
     return;
   }
 
@@ -307,47 +465,19 @@ void handleThresholdPost() {
     return;
   }
 
+  // 先在副本上校验全部字段，请求确定生效后才为节点分配状态，畸形请求不会占用节点表。
+  const NodeState* existing = findNode(node_id);
+  ThresholdConfig updated = existing != nullptr ? existing->thresholds : ThresholdConfig();
   String error;
   bool touched = false;
 
-  if (doc.containsKey("temp")) {
-    if (!updateThresholdValue("temp", threshold_config.temp, doc["temp"], -40.0f, 125.0f, error)) {
-      StaticJsonDocument<96> resp;
-      resp["error"] = error;
-      String serialized;
-      serializeJson(resp, serialized);
-      server->send(422, "application/json", serialized);
-      return;
+  for (size_t i = 0; i < kMetricCount; ++i) {
+    const device_registry::MetricSpec& spec = kMetrics[i];
+    if (!doc.containsKey(spec.key)) {
+      continue;
     }
-    touched = true;
-  }
-
-  if (doc.containsKey("humi")) {
-    if (!updateThresholdValue("humi", threshold_config.humi, doc["humi"], 0.0f, 100.0f, error)) {
-      StaticJsonDocument<96> resp;
-      resp["error"] = error;
-      String serialized;
-      serializeJson(resp, serialized);
-      server->send(422, "application/json", serialized);
-      return;
-    }
-    touched = true;
-  }
-
-  if (doc.containsKey("soil")) {
-    if (!updateThresholdValue("soil", threshold_config.soil, doc["soil"], 0.0f, 100.0f, error)) {
-      StaticJsonDocument<96> resp;
-      resp["error"] = error;
-      String serialized;
-      serializeJson(resp, serialized);
-      server->send(422, "application/json", serialized);
-      return;
-    }
-    touched = true;
-  }
-
-  if (doc.containsKey("lux")) {
-    if (!updateThresholdValue("lux", threshold_config.lux, doc["lux"], 0.0f, 200000.0f, error)) {
+    if (!updateThresholdValue(spec.key, updated.metrics[i], doc[spec.key], spec.threshold_min,
+                              spec.threshold_max, error)) {
       StaticJsonDocument<96> resp;
       resp["error"] = error;
       String serialized;
@@ -363,29 +493,59 @@ void handleThresholdPost() {
     return;
   }
 
-  StaticJsonDocument<256> resp;
+  NodeState* node = ensureNode(node_id);
+  if (node == nullptr) {
+    server->send(503, "application/json", F("{\"error\":\"节点表内存不足\"}"));
+    return;
+  }
+  node->thresholds = updated;
+
+  DynamicJsonDocument resp(kThresholdDocSize + JSON_STRING_SIZE(node->alarm.reason.length()));
   resp["ok"] = true;
-  fillThresholdJson(resp.createNestedObject("thresholds"));
-  fillAlarmJson(resp.createNestedObject("alarm"));
-  String serialized;
-  serializeJson(resp, serialized);
-  server->send(200, "application/json", serialized);
+  resp["node"] = node_id;
+  fillThresholdJson(resp.createNestedObject("thresholds"), node->thresholds);
+  fillAlarmJson(resp.createNestedObject("alarm"), node->alarm);
+  sendJsonDocument(resp);
 }
 
 void handleFallbackRoot() {
-  if (!server) {
-    return;
-  }
   server->send(200, "text/html", buildFallbackPage());
 }
 
-void handleIndexHtml() {
-  if (!server) {
+// LittleFS 挂载需要扫描元数据块，放到首个静态资源请求时再做，让 /api/ 在启动后尽早可用。
+// 只尝试一次，失败后持续使用回退页面。
+bool ensureFsMounted() {
+  if (!littleFsMountAttempted) {
+    littleFsMountAttempted = true;
+    littleFsMounted = LittleFS.begin();
+    if (littleFsMounted) {
+      boot_profile::mark(boot_profile::kFsMounted);
+    }
+  }
+  return littleFsMounted;
+}
+
+void streamStaticFile(const char* path, const __FlashStringHelper* content_type) {
+  if (!ensureFsMounted()) {
+    server->send(404, "text/plain", "Not found");
     return;
   }
 
-  if (!littleFsMounted) {
+  File file = LittleFS.open(path, "r");
+  if (!file) {
+    server->send(404, "text/plain", "Not found");
+    return;
+  }
+
+  server->streamFile(file, content_type);
+  file.close();
+  boot_profile::mark(boot_profile::kFirstResponse);
+}
+
+void handleIndexHtml() {
+  if (!ensureFsMounted()) {
     handleFallbackRoot();
+    boot_profile::mark(boot_profile::kFirstResponse);
     return;
   }
 
@@ -397,75 +557,309 @@ void handleIndexHtml() {
 
   server->streamFile(file, F("text/html"));
   file.close();
+  boot_profile::mark(boot_profile::kFirstResponse);
 }
 
-void handleMessagesRequest() {
-  if (!server) {
-    return;
-  }
+void handleIndexCss() {
+  streamStaticFile("/index.css", F("text/css"));
+}
+
+void handleIndexJs() {
+  streamStaticFile("/index.js", F("application/javascript"));
+}
 
+void handleMessagesRequest(const api_router::RouteParams&) {
   uint32_t after = 0;
   if (server->hasArg("after")) {
     after = static_cast<uint32_t>(server->arg("after").toInt());
   }
 
-  String body;
-  for (const auto& message : message_log) {
-    if (message.id > after) {
-      body += message.payload;
-      body += '\n';
+  uint32_t before = last_message_id + 1;
+  if (server->hasArg("before")) {
+    const long parsed = server->arg("before").toInt();
+    if (parsed > 0 && static_cast<uint32_t>(parsed) < before) {
+      before = static_cast<uint32_t>(parsed);
+    }
+  }
+
+  size_t limit = kMaxMessages;
+  if (server->hasArg("limit")) {
+    const long parsed = server->arg("limit").toInt();
+    if (parsed > 0 && static_cast<size_t>(parsed) < limit) {
+      limit = static_cast<size_t>(parsed);
+    }
+  }
+
+  // 只读接口不为未出现过的节点分配状态，未知节点按空结果返回。
+  uint8_t first_source = 0;
+  uint8_t end_source = kMessageSourceCount;
+  if (server->hasArg("node")) {
+    uint8_t node_id = 0;
+    if (!parseRequestNode(server->arg("node"), node_id)) {
+      return;
+    }
+    if (findNode(node_id) == nullptr) {
+      server->sendHeader(F("X-Last-Message-Id"), String(last_message_id));
+      server->send(200, "application/x-ndjson", "");
+      return;
+    }
+    first_source = node_id;
+    end_source = node_id + 1;
+  }
+
+  bool selected[kMessageTypeCount] = {};
+  bool filtered = false;
+  if (server->hasArg("type")) {
+    const String types = server->arg("type");
+    int start = 0;
+    while (start <= static_cast<int>(types.length())) {
+      int end = types.indexOf(',', start);
+      if (end < 0) {
+        end = types.length();
+      }
+      const String name = types.substring(start, end);
+      start = end + 1;
+      if (name.length() == 0) {
+        continue;
+      }
+      uint8_t index = 0;
+      while (index < kMessageTypeCount && name != kMessageTypeNames[index]) {
+        ++index;
+      }
+      if (index == kMessageTypeCount) {
+        server->send(400, "application/json", F("{\"error\":\"type 非法\"}"));
+        return;
+      }
+      selected[index] = true;
+      filtered = true;
+    }
+  }
+
+  // 每个来源、每个选中类型一个游标，从最新一条沿链表向前走，按编号归并出最新的 limit 条。
+  MessageRef cursors[kMessageSourceCount][kMessageTypeCount] = {};
+  for (uint8_t s = first_source; s < end_source; ++s) {
+    for (uint8_t t = 0; t < kMessageTypeCount; ++t) {
+      if (filtered && !selected[t]) {
+        continue;
+      }
+      MessageRef& cursor = cursors[s][t];
+      cursor = message_sources[s].last_of_type[t];
+      while (cursor.id >= before) {
+        const MessageEntry* entry = resolveMessage(cursor);
+        cursor = entry != nullptr ? entry->prev_same_type : MessageRef();
+      }
+    }
+  }
+
+  const MessageEntry* matches[kMaxMessages];
+  size_t match_count = 0;
+  while (match_count < limit) {
+    MessageRef* newest = nullptr;
+    for (uint8_t s = first_source; s < end_source; ++s) {
+      for (MessageRef& cursor : cursors[s]) {
+        if (cursor.id > after && (newest == nullptr || cursor.id > newest->id)) {
+          newest = &cursor;
+        }
+      }
+    }
+    if (newest == nullptr) {
+      break;
+    }
+    const MessageEntry* entry = resolveMessage(*newest);
+    if (entry == nullptr) {
+      *newest = MessageRef();
+      continue;
     }
+    matches[match_count++] = entry;
+    *newest = entry->prev_same_type;
+  }
+
+  String body;
+  while (match_count > 0) {
+    const MessageEntry* entry = matches[--match_count];
+    body += entry->payload;
+    body += '\n';
   }
 
-  server->sendHeader(F("Cache-Control"), F("no-store"));
   server->sendHeader(F("X-Last-Message-Id"), String(last_message_id));
   server->send(200, "application/x-ndjson", body);
 }
 
-void handleStateRequest() {
-  if (!server) {
+// wifi、node、nodes、stm32ReportedIp、uptimeSeconds、latestData、latestRaw、latestAck、thresholds、alarm、
+// serialLink、power 共 12 个顶层字段。
+constexpr size_t kStateDocSize = JSON_OBJECT_SIZE(12) + JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(15) +
+                                 JSON_ARRAY_SIZE(kMaxNodes) + JSON_OBJECT_SIZE(kMetricCount + kActuatorCount + 1) +
+                                 JSON_OBJECT_SIZE(kMetricCount) + JSON_OBJECT_SIZE(4) +
+                                 JSON_OBJECT_SIZE(kMetricCount) + kAlarmJsonSize + JSON_OBJECT_SIZE(5) +
+                                 JSON_OBJECT_SIZE(4);
+
+void fillNodeStateJson(JsonDocument& doc, const NodeState& node) {
+  doc["stm32ReportedIp"] = node.reported_ip;
+
+  const SensorSnapshot& latest_sensor = node.sensor;
+  if (latest_sensor.valid) {
+    JsonObject data = doc.createNestedObject("latestData");
+    for (size_t i = 0; i < kMetricCount; ++i) {
+      data[kMetrics[i].key] = latest_sensor.metrics[i];
+    }
+    for (size_t i = 0; i < kActuatorCount; ++i) {
+      data[kActuators[i].key] = latest_sensor.switches[i];
+    }
+    data["ageMs"] = millis() - latest_sensor.updated_at;
+
+    JsonObject raw = doc.createNestedObject("latestRaw");
+    for (size_t i = 0; i < kMetricCount; ++i) {
+      raw[kMetrics[i].key] = latest_sensor.raw[i];
+    }
+  }
+
+  if (node.ack.valid) {
+    JsonObject ack = doc.createNestedObject("latestAck");
+    ack["target"] = node.ack.target;
+    ack["action"] = node.ack.action;
+    ack["result"] = node.ack.result;
+    ack["ageMs"] = millis() - node.ack.updated_at;
+  }
+
+  fillThresholdJson(doc.createNestedObject("thresholds"), node.thresholds);
+  fillAlarmJson(doc.createNestedObject("alarm"), node.alarm);
+}
+
+// 网关级字段（wifi、nodes、serialLink、power 等）总是返回；所选节点尚未上线时节点级字段为 null，
+// 前端据此清空卡片并仍能刷新节点列表。只读查询不为未知节点分配状态。
+void handleStateRequest(const api_router::RouteParams&) {
+  uint8_t node_id = 0;
+  if (!parseRequestNode(server->arg("node"), node_id)) {
     return;
   }
+  const NodeState* node = findNode(node_id);
 
-  StaticJsonDocument<384> doc;
+  size_t capacity = kStateDocSize;
+  if (node != nullptr) {
+    capacity += JSON_STRING_SIZE(node->reported_ip.length()) + JSON_STRING_SIZE(node->ack.target.length()) +
+                JSON_STRING_SIZE(node->ack.action.length()) + JSON_STRING_SIZE(node->ack.result.length()) +
+                JSON_STRING_SIZE(node->alarm.reason.length());
+  }
+  DynamicJsonDocument doc(capacity);
   JsonObject wifi = doc.createNestedObject("wifi");
   wifi["connected"] = wifi_manager::isConnected();
   wifi["ip"] = wifi_manager::localIP().toString();
 
-  doc["stm32ReportedIp"] = last_reported_ip;
+  doc["node"] = node_id;
+  JsonArray nodeList = doc.createNestedArray("nodes");
+  for (uint8_t i = 0; i < kMaxNodes; ++i) {
+    if (nodes[i] != nullptr && nodes[i]->seen) {
+      nodeList.add(i);
+    }
+  }
+
   doc["uptimeSeconds"] = millis() / 1000;
 
-  if (latest_sensor.valid) {
-    JsonObject data = doc.createNestedObject("latestData");
-    data["temp"] = latest_sensor.temp;
-    data["humi"] = latest_sensor.humi;
-    data["soil"] = latest_sensor.soil;
-    data["lux"] = latest_sensor.lux;
-    data["water"] = latest_sensor.water;
-    data["light"] = latest_sensor.light;
-    data["fan"] = latest_sensor.fan;
-    data["buzzer"] = latest_sensor.buzzer;
-    data["ageMs"] = millis() - latest_sensor.updated_at;
+  if (node == nullptr) {
+    doc["stm32ReportedIp"] = nullptr;
+    doc["latestData"] = nullptr;
+    doc["latestRaw"] = nullptr;
+    doc["latestAck"] = nullptr;
+    doc["thresholds"] = nullptr;
+    doc["alarm"] = nullptr;
+  } else {
+    fillNodeStateJson(doc, *node);
   }
 
-  if (last_ack.valid) {
-    JsonObject ack = doc.createNestedObject("latestAck");
-    ack["target"] = last_ack.target;
-    ack["action"] = last_ack.action;
-    ack["result"] = last_ack.result;
-    ack["ageMs"] = millis() - last_ack.updated_at;
+  const serial_bridge::LinkStats& link = serial_bridge::stats();
+  JsonObject serialLink = doc.createNestedObject("serialLink");
+  serialLink["bytes"] = link.bytes_received;
+  serialLink["frames"] = link.frames_delivered;
+  serialLink["dropped"] = link.frames_dropped;
+  serialLink["overruns"] = link.rx_overruns;
+  serialLink["longestLine"] = link.longest_line;
+
+  JsonObject power = doc.createNestedObject("power");
+  power["mode"] = power_manager::modeName(power_manager::mode());
+  power["dutyCycle"] = power_manager::dutyCycle();
+  power["reportSeconds"] = power_manager::reportIntervalSeconds(power_manager::mode());
+  power["stations"] = wifi_manager::stationCount();
+
+  sendJsonDocument(doc);
+}
+
+constexpr size_t kStatsDocSize =
+    JSON_OBJECT_SIZE(3) + JSON_OBJECT_SIZE(sensor_stats::kWindowCount) +
+    sensor_stats::kWindowCount * (JSON_OBJECT_SIZE(kMetricCount) + kMetricCount * JSON_OBJECT_SIZE(6));
+
+void handleStatsRequest(const api_router::RouteParams&) {
+  uint8_t node_id = 0;
+  NodeState* node = nullptr;
+  if (!findRequestNode(node_id, node)) {
+    return;
   }
 
-  fillThresholdJson(doc.createNestedObject("thresholds"));
-  fillAlarmJson(doc.createNestedObject("alarm"));
+  const unsigned long now = millis();
+  DynamicJsonDocument doc(kStatsDocSize);
+  doc["ok"] = true;
+  doc["node"] = node_id;
+  JsonObject windows = doc.createNestedObject("windows");
+  for (uint8_t w = 0; w < sensor_stats::kWindowCount; ++w) {
+    const sensor_stats::Window window = static_cast<sensor_stats::Window>(w);
+    JsonObject windowObject = windows.createNestedObject(sensor_stats::windowName(window));
+    for (size_t i = 0; i < kMetricCount; ++i) {
+      sensor_stats::Summary summary;
+      if (!sensor_stats::summarize(node->stats[i], window, now, summary)) {
+        windowObject[kMetrics[i].key] = nullptr;
+        continue;
+      }
+      JsonObject metric = windowObject.createNestedObject(kMetrics[i].key);
+      metric["count"] = summary.count;
+      metric["min"] = summary.min;
+      metric["max"] = summary.max;
+      metric["mean"] = summary.mean;
+      metric["stddev"] = summary.stddev;
+      metric["aboveMs"] = summary.above_ms;
+    }
+  }
 
-  String response;
-  serializeJson(doc, response);
-  server->sendHeader(F("Cache-Control"), F("no-store"));
-  server->send(200, "application/json", response);
+  sendJsonDocument(doc);
+}
+
+constexpr size_t kSchemaDocSize = JSON_OBJECT_SIZE(3) + JSON_ARRAY_SIZE(kMetricCount) +
+                                  kMetricCount * (JSON_OBJECT_SIZE(7) + JSON_OBJECT_SIZE(3)) +
+                                  JSON_ARRAY_SIZE(kActuatorCount) + kActuatorCount * JSON_OBJECT_SIZE(3) +
+                                  JSON_ARRAY_SIZE(3);
+
+void handleSchemaRequest(const api_router::RouteParams&) {
+  DynamicJsonDocument doc(kSchemaDocSize);
+  JsonArray metrics = doc.createNestedArray("metrics");
+  for (const auto& spec : kMetrics) {
+    JsonObject metric = metrics.createNestedObject();
+    metric["key"] = spec.key;
+    metric["label"] = spec.label;
+    metric["unit"] = spec.unit;
+    metric["decimals"] = spec.decimals;
+    metric["min"] = spec.threshold_min;
+    metric["max"] = spec.threshold_max;
+    JsonObject filter = metric.createNestedObject("filter");
+    filter["median"] = spec.filter.median_window;
+    filter["emaAlpha"] = spec.filter.ema_alpha;
+    filter["maxRatePerS"] = spec.filter.max_rate_per_s;
+  }
+
+  JsonArray actuators = doc.createNestedArray("actuators");
+  for (const auto& spec : kActuators) {
+    JsonObject actuator = actuators.createNestedObject();
+    actuator["key"] = spec.key;
+    actuator["label"] = spec.label;
+    actuator["maxPulseMs"] = spec.max_pulse_ms;
+  }
+
+  JsonArray actions = doc.createNestedArray("actions");
+  actions.add("on");
+  actions.add("off");
+  actions.add("pulse");
+
+  sendJsonDocument(doc);
 }
 
-bool validateCommand(JsonDocument& doc, String& error) {
+bool validateCommand(JsonDocument& doc, ParsedCommand& command, String& error) {
   const char* target = doc["target"];
   const char* action = doc["action"];
 
@@ -474,37 +868,48 @@ bool validateCommand(JsonDocument& doc, String& error) {
     return false;
   }
 
-  if (strcmp(target, "water") != 0 && strcmp(target, "light") != 0 && strcmp(target, "fan") != 0 &&
-      strcmp(target, "buzzer") != 0) {
+  const int actuator = device_registry::findActuator(target);
+  if (actuator == device_registry::kNotFound) {
     error = F("target 非法");
     return false;
   }
 
-  if (strcmp(action, "on") != 0 && strcmp(action, "off") != 0 && strcmp(action, "pulse") != 0) {
+  command.target = static_cast<size_t>(actuator);
+  if (!command_limiter::parseAction(action, command.action)) {
     error = F("action 非法");
     return false;
   }
 
-  if (strcmp(action, "pulse") == 0) {
+  if (command.action == command_limiter::Action::kPulse) {
     if (!doc.containsKey("time")) {
       error = F("pulse 指令缺少 time");
       return false;
     }
     const int pulse_ms = doc["time"];
-    if (pulse_ms <= 0 || pulse_ms > 10000) {
+    if (pulse_ms <= 0 || pulse_ms > kActuators[actuator].max_pulse_ms) {
       error = F("time 超出范围");
       return false;
     }
+    command.pulse_ms = static_cast<uint16_t>(pulse_ms);
   }
 
   return true;
 }
 
-void handleCommandRequest() {
-  if (!server) {
-    return;
+void sendCommandOutcome(const char* result, uint32_t message_id) {
+  StaticJsonDocument<96> resp;
+  resp["result"] = result;
+  if (message_id != 0) {
+    resp["queuedId"] = message_id;
+  } else {
+    resp["queuedId"] = nullptr;
   }
+  String response;
+  serializeJson(resp, response);
+  server->send(200, "application/json", response);
+}
 
+void handleCommandRequest(const api_router::RouteParams&) {
   if (!server->hasArg("plain")) {
     server->send(400, "application/json", F("{\"error\":\"缺少 JSON 负载\"}"));
     return;
@@ -518,10 +923,23 @@ void handleCommandRequest() {
     return;
   }
 
+  // 目标节点取自请求体的 node 字段，缺省时取 ?node= 参数。
+  uint8_t node_id = 0;
+  if (doc.containsKey("node") && !doc["node"].is<long>()) {
+    server->send(400, "application/json", F("{\"error\":\"node 非法\"}"));
+    return;
+  }
+  const String node_arg = doc.containsKey("node") ? String(doc["node"].as<long>()) : server->arg("node");
+  if (!parseRequestNode(node_arg, node_id)) {
+    return;
+  }
+
   doc["type"] = "cmd";
+  doc["node"] = node_id;
 
   String error;
-  if (!validateCommand(doc, error)) {
+  ParsedCommand command;
+  if (!validateCommand(doc, command, error)) {
     StaticJsonDocument<96> resp;
     resp["error"] = error;
     String serialized;
@@ -530,6 +948,35 @@ void handleCommandRequest() {
     return;
   }
 
+  // 命令校验通过才为目标节点分配状态（限流与待回执记录挂在节点上）。
+  NodeState* node = ensureNode(node_id);
+  if (node == nullptr) {
+    server->send(503, "application/json", F("{\"error\":\"节点表内存不足\"}"));
+    return;
+  }
+
+  const unsigned long now = millis();
+  const SensorSnapshot& latest_sensor = node->sensor;
+  command_limiter::TargetState& target_state = node->commands[command.target];
+  const int switch_state = latest_sensor.valid ? latest_sensor.switches[command.target] : -1;
+  const command_limiter::Result verdict = command_limiter::evaluate(
+      target_state, command.action, command.pulse_ms, switch_state, latest_sensor.updated_at, now);
+
+  switch (verdict.verdict) {
+    case command_limiter::Verdict::kSuppressed:
+      sendCommandOutcome("suppressed", 0);
+      return;
+    case command_limiter::Verdict::kCoalesced:
+      sendCommandOutcome("coalesced", verdict.message_id);
+      return;
+    case command_limiter::Verdict::kRateLimited:
+      server->sendHeader(F("Retry-After"), String((verdict.retry_after_ms + 999) / 1000));
+      server->send(429, "application/json", F("{\"error\":\"命令过于频繁，请稍后再试\"}"));
+      return;
+    case command_limiter::Verdict::kSend:
+      break;
+  }
+
   if (!serial_bridge::sendJson(doc)) {
     server->send(500, "application/json", F("{\"error\":\"串口发送失败\"}"));
     return;
@@ -537,43 +984,43 @@ void handleCommandRequest() {
 
   String serialized;
   serializeJson(doc, serialized);
-  addMessage(serialized);
+  addMessage(serialized, kMessageCmd, node_id);
+  command_limiter::markSent(target_state, command.action, command.pulse_ms, last_message_id, now);
 
-  StaticJsonDocument<96> resp;
-  resp["result"] = "sent";
-  resp["queuedId"] = last_message_id;
-  String response;
-  serializeJson(resp, response);
-  server->send(200, "application/json", response);
+  sendCommandOutcome("sent", last_message_id);
 }
 
 void handleNotFound() {
-  if (!server) {
-    return;
-  }
-
-  if (!littleFsMounted && server->uri() == "/") {
-    handleFallbackRoot();
-    return;
-  }
-
   server->send(404, "text/plain", "Not found");
 }
 
-void updateSensorSnapshot(const JsonDocument& doc) {
+void updateSensorSnapshot(NodeState& node, const JsonDocument& doc) {
+  const unsigned long now = millis();
+  SensorSnapshot& latest_sensor = node.sensor;
   latest_sensor.valid = true;
-  latest_sensor.temp = doc["temp"] | latest_sensor.temp;
-  latest_sensor.humi = doc["humi"] | latest_sensor.humi;
-  latest_sensor.soil = doc["soil"] | latest_sensor.soil;
-  latest_sensor.lux = doc["lux"] | latest_sensor.lux;
-  latest_sensor.water = doc["water"] | latest_sensor.water;
-  latest_sensor.light = doc["light"] | latest_sensor.light;
-  latest_sensor.fan = doc["fan"] | latest_sensor.fan;
-  latest_sensor.buzzer = doc["buzzer"] | latest_sensor.buzzer;
-  latest_sensor.updated_at = millis();
-}
-
-void updateAckSnapshot(const JsonDocument& doc) {
+  for (size_t i = 0; i < kMetricCount; ++i) {
+    JsonVariantConst value = doc[kMetrics[i].key];
+    if (value.isNull() || !isNumericVariant(value)) {
+      continue;
+    }
+    const NumericThreshold& threshold = node.thresholds.metrics[i];
+    latest_sensor.raw[i] = value.as<float>();
+    latest_sensor.metrics[i] = sensor_filter::apply(node.filters[i], kMetrics[i].filter, latest_sensor.raw[i], now);
+    sensor_stats::record(node.stats[i], latest_sensor.metrics[i], threshold.enabled, threshold.value, now);
+  }
+  for (size_t i = 0; i < kActuatorCount; ++i) {
+    latest_sensor.switches[i] = doc[kActuators[i].key] | latest_sensor.switches[i];
+  }
+  latest_sensor.updated_at = now;
+}
+
+void updateAckSnapshot(NodeState& node, const JsonDocument& doc) {
+  const int actuator = device_registry::findActuator(doc["target"].as<const char*>());
+  if (actuator != device_registry::kNotFound) {
+    command_limiter::markAcked(node.commands[actuator], millis());
+  }
+
+  AckSnapshot& last_ack = node.ack;
   last_ack.valid = true;
   last_ack.target = doc["target"] | "";
   last_ack.action = doc["action"] | "";
@@ -581,6 +1028,144 @@ void updateAckSnapshot(const JsonDocument& doc) {
   last_ack.updated_at = millis();
 }
 
+void handleMessageByIdRequest(const api_router::RouteParams& params) {
+  uint32_t id = 0;
+  if (!params.toUint(id)) {
+    server->send(400, "application/json", F("{\"error\":\"消息编号非法\"}"));
+    return;
+  }
+
+  const MessageEntry* entry = findMessage(id);
+  if (entry == nullptr) {
+    server->send(404, "application/json", F("{\"error\":\"消息不存在或已被覆盖\"}"));
+    return;
+  }
+
+  String body = entry->payload;
+  body += '\n';
+  server->sendHeader(F("X-Message-Type"), kMessageTypeNames[entry->type]);
+  if (entry->node != kNoNode) {
+    server->sendHeader(F("X-Node-Id"), String(entry->node));
+  }
+  server->send(200, "application/x-ndjson", body);
+}
+
+void handleMetricsRequest(const api_router::RouteParams& params);
+
+struct RouteTiming {
+  uint32_t count = 0;
+  uint32_t total_us = 0;
+  uint32_t max_us = 0;
+};
+
+constexpr api_router::Route kApiRoutes[] = {
+    {HTTP_GET, "messages", handleMessagesRequest, api_router::kRouteNone},
+    {HTTP_GET, "messages/<id>", handleMessageByIdRequest, api_router::kRouteNone},
+    {HTTP_GET, "state", handleStateRequest, api_router::kRouteNone},
+    {HTTP_GET, "stats", handleStatsRequest, api_router::kRouteNone},
+    {HTTP_GET, "schema", handleSchemaRequest, api_router::kRouteCacheable},
+    {HTTP_GET, "metrics", handleMetricsRequest, api_router::kRouteNone},
+    {HTTP_POST, "cmd", handleCommandRequest, api_router::kRouteNone},
+    {HTTP_GET, "thresholds", handleThresholdGet, api_router::kRouteNone},
+    {HTTP_POST, "thresholds", handleThresholdPost, api_router::kRouteNone},
+};
+constexpr size_t kApiRouteCount = sizeof(kApiRoutes) / sizeof(kApiRoutes[0]);
+RouteTiming route_timings[kApiRouteCount];
+
+constexpr size_t kMetricsDocSize = JSON_OBJECT_SIZE(5) + JSON_OBJECT_SIZE(boot_profile::kPhaseCount + 1) +
+                                   JSON_OBJECT_SIZE(4) + JSON_ARRAY_SIZE(kApiRouteCount) +
+                                   kApiRouteCount * JSON_OBJECT_SIZE(5);
+
+void handleMetricsRequest(const api_router::RouteParams&) {
+  DynamicJsonDocument doc(kMetricsDocSize);
+  doc["uptimeMs"] = millis();
+  doc["freeHeap"] = ESP.getFreeHeap();
+  // 启动各阶段距上电的毫秒数，未到达的阶段为 null。
+  JsonObject boot = doc.createNestedObject("boot");
+  for (uint8_t i = 0; i < boot_profile::kPhaseCount; ++i) {
+    const boot_profile::Phase phase = static_cast<boot_profile::Phase>(i);
+    if (boot_profile::reached(phase)) {
+      boot[boot_profile::phaseName(phase)] = boot_profile::at(phase);
+    } else {
+      boot[boot_profile::phaseName(phase)] = nullptr;
+    }
+  }
+  boot["apResumed"] = wifi_manager::accessPointResumed();
+  // 命令限流计数覆盖所有节点，属于网关级指标。
+  const command_limiter::Counters& command_counters = command_limiter::counters();
+  JsonObject commands = doc.createNestedObject("commands");
+  commands["sent"] = command_counters.sent;
+  commands["coalesced"] = command_counters.coalesced;
+  commands["suppressed"] = command_counters.suppressed;
+  commands["rateLimited"] = command_counters.rate_limited;
+  JsonArray routes = doc.createNestedArray("routes");
+  for (size_t i = 0; i < kApiRouteCount; ++i) {
+    JsonObject route = routes.createNestedObject();
+    route["method"] = api_router::methodName(kApiRoutes[i].method);
+    route["pattern"] = kApiRoutes[i].pattern;
+    route["count"] = route_timings[i].count;
+    route["avgUs"] = route_timings[i].count > 0 ? route_timings[i].total_us / route_timings[i].count : 0;
+    route["maxUs"] = route_timings[i].max_us;
+  }
+
+  sendJsonDocument(doc);
+}
+
+// 所有 /api/ 请求共用的入口：前置钩子统一写缓存头，后置钩子记录处理耗时。
+void dispatchApiRequest(HTTPMethod method, const String& uri) {
+  size_t index = 0;
+  api_router::RouteParams params;
+  const api_router::MatchResult result = api_router::match(
+      kApiRoutes, kApiRouteCount, method, uri.c_str() + api_router::kPrefixLength, index, params);
+  if (result == api_router::MatchResult::kNotFound) {
+    server->send(404, "application/json", F("{\"error\":\"接口不存在\"}"));
+    return;
+  }
+  if (result == api_router::MatchResult::kMethodNotAllowed) {
+    server->send(405, "application/json", F("{\"error\":\"请求方法不支持\"}"));
+    return;
+  }
+
+  const api_router::Route& route = kApiRoutes[index];
+  const unsigned long started_us = micros();
+  if ((route.flags & api_router::kRouteCacheable) != 0) {
+    server->sendHeader(F("Cache-Control"), F("max-age=300"));
+  } else {
+    server->sendHeader(F("Cache-Control"), F("no-store"));
+  }
+
+  route.handler(params);
+
+  const uint32_t elapsed_us = micros() - started_us;
+  RouteTiming& timing = route_timings[index];
+  timing.count += 1;
+  timing.total_us += elapsed_us;
+  if (elapsed_us > timing.max_us) {
+    timing.max_us = elapsed_us;
+  }
+}
+
+// 整个 /api/ 前缀只注册这一个处理器，由它在常量路由表中分派。
+class ApiRequestHandler : public RequestHandler {
+ public:
+  bool canHandle(HTTPMethod method, const String& uri) override {
+    (void)method;
+    return strncmp(uri.c_str(), api_router::kPrefix, api_router::kPrefixLength) == 0;
+  }
+
+  bool canUpload(const String& uri) override {
+    (void)uri;
+    return false;
+  }
+
+  bool handle(ESP8266WebServer& web_server, HTTPMethod method, const String& uri) override {
+    (void)web_server;
+    dispatchApiRequest(method, uri);
+    boot_profile::mark(boot_profile::kFirstResponse);
+    return true;
+  }
+};
+
 }  // namespace
 
 void start(uint16_t port) {
@@ -590,31 +1175,19 @@ void start(uint16_t port) {
     server = nullptr;
   }
 
-  if (littleFsMounted) {
-    LittleFS.end();
-    littleFsMounted = false;
-  }
-
-  littleFsMounted = LittleFS.begin();
-  if (!littleFsMounted) {
-    // Serial.println(F("LittleFS 挂载失败，将使用回退页面。"));
-  }
+  // 单节点部署只有节点 0，启动即分配，页面在首帧到达前也能读到阈值与报警配置。
+  ensureNode(0);
 
   server = new ESP8266WebServer(port);
 
-  if (littleFsMounted) {
-    server->on("/", handleIndexHtml);
-    server->serveStatic("/index.css", LittleFS, "/index.css");
-    server->serveStatic("/index.js", LittleFS, "/index.js");
-  } else {
-    server->on("/", handleFallbackRoot);
-  }
+  // 处理器按注册顺序逐个匹配，/api/ 请求最频繁，放在链表头部，无需先经过静态资源的 String 比较。
+  server->addHandler(new ApiRequestHandler());
+
+  // 静态资源统一走延迟挂载的处理函数，LittleFS 不可用时 "/" 回退到内置状态页。
+  server->on("/", HTTP_GET, handleIndexHtml);
+  server->on("/index.css", HTTP_GET, handleIndexCss);
+  server->on("/index.js", HTTP_GET, handleIndexJs);
 
-  server->on("/api/messages", HTTP_GET, handleMessagesRequest);
-  server->on("/api/state", HTTP_GET, handleStateRequest);
-  server->on("/api/cmd", HTTP_POST, handleCommandRequest);
-  server->on("/api/thresholds", HTTP_GET, handleThresholdGet);
-  server->on("/api/thresholds", HTTP_POST, handleThresholdPost);
   server->onNotFound(handleNotFound);
   server->begin();
 }
@@ -630,29 +1203,48 @@ bool isRunning() {
 }
 
 void handleSerialLine(const String& line) {
-  addMessage(line);
-
   StaticJsonDocument<256> doc;
   const DeserializationError err = deserializeJson(doc, line);
+  const char* type = err ? nullptr : doc["type"].as<const char*>();
+
+  // 缺少 node 字段的帧归属节点 0；node 非法的帧只记入全局日志，不更新任何节点状态。
+  uint8_t node_id = kNoNode;
+  if (!err) {
+    JsonVariantConst nodeVar = doc["node"];
+    if (nodeVar.isNull()) {
+      node_id = 0;
+    } else if (nodeVar.is<long>() && nodeVar.as<long>() >= 0 && nodeVar.as<long>() < kMaxNodes) {
+      node_id = static_cast<uint8_t>(nodeVar.as<long>());
+    }
+  }
+  NodeState* node = ensureNode(node_id);
+  if (node != nullptr) {
+    node->seen = true;
+  }
+  addMessage(line, classifyMessage(type), node != nullptr ? node_id : kNoNode);
+
   if (err) {
     // Serial.print(F("解析串口 JSON 失败: "));
     // Serial.println(err.c_str());
     return;
   }
 
-  const char* type = doc["type"];
   if (type == nullptr) {
     // Serial.println(F("串口消息缺少 type 字段"));
     return;
   }
 
+  if (node == nullptr) {
+    return;
+  }
+
   if (strcmp(type, "data") == 0) {
-    updateSensorSnapshot(doc);
-    checkAndTriggerAlarm(doc);
+    updateSensorSnapshot(*node, doc);
+    checkAndTriggerAlarm(node_id, *node, doc);
   } else if (strcmp(type, "ack") == 0) {
-    updateAckSnapshot(doc);
+    updateAckSnapshot(*node, doc);
   } else if (strcmp(type, "status") == 0) {
-    last_reported_ip = doc["ip"] | last_reported_ip;
+    node->reported_ip = doc["ip"] | node->reported_ip;
   }
 }
 
@@ -8,21 +8,54 @@ namespace wifi_manager {
 
 namespace {
 bool apRunning = false;
+bool apResumed = false;
+
+bool usesPassword(const char* password) {
+  // Password shorter than 8 characters disables WPA2 on ESP8266, fall back to open AP.
+  return password != nullptr && password[0] != '\0' && strlen(password) >= 8;
+}
 }  // namespace
 
 void startAccessPoint(const char* ssid, const char* password) {
+  // 下次上电的恢复路径读取 Flash 中的热点配置，显式开启持久化而不依赖 core 的默认值；
+  // 只有恢复失败（首次启动或配置变化）才会走到这里，Flash 写入次数有限。
+  WiFi.persistent(true);
   WiFi.mode(WIFI_AP);
   WiFi.softAPdisconnect(true);
   apRunning = false;
+  apResumed = false;
 
-  if (password != nullptr && password[0] != '\0' && strlen(password) >= 8) {
+  if (usesPassword(password)) {
     apRunning = WiFi.softAP(ssid, password);
   } else {
-    // Password shorter than 8 characters disables WPA2 on ESP8266, fall back to open AP.
     apRunning = WiFi.softAP(ssid);
   }
 }
 
+bool resumeAccessPoint(const char* ssid, const char* password) {
+  // core 3.x 默认在上电时关闭 Wi-Fi（getMode() 恒为 WIFI_OFF），链接进 enableWiFiAtBootTime()
+  // 才会让 SDK 按 Flash 中保存的配置恢复热点；该函数为空实现，作用在链接期，依赖的 core 版本见 platformio.ini。
+  enableWiFiAtBootTime();
+  if (WiFi.getMode() != WIFI_AP) {
+    return false;
+  }
+  // softAPIP 为 0 说明接口尚未真正启动，仍需走完整流程。
+  if (WiFi.softAPIP() == IPAddress(0, 0, 0, 0)) {
+    return false;
+  }
+  const char* expected_psk = usesPassword(password) ? password : "";
+  if (WiFi.softAPSSID() != ssid || WiFi.softAPPSK() != expected_psk) {
+    return false;
+  }
+  apRunning = true;
+  apResumed = true;
+  return true;
+}
+
+bool accessPointResumed() {
+  return apResumed;
+}
+
 bool isConnected() {
   return apRunning;
 }
@@ -31,4 +64,12 @@ IPAddress localIP() {
   return WiFi.softAPIP();
 }
 
+uint8_t stationCount() {
+  return WiFi.softAPgetStationNum();
+}
+
+void setLowPower(bool enabled) {
+  WiFi.setSleepMode(enabled ? WIFI_LIGHT_SLEEP : WIFI_MODEM_SLEEP);
+}
+
 }  // namespace wifi_manager
@@ -0,0 +1,210 @@
+// 原理说明：无头浏览器帧时间基准。本地起一个静态服务托管 data/ 并伪造 /api/ 接口，页面加载后先灌满 1000 条日志，
+// 再按设定速率（默认 1000 条/分钟）调用 appendMessageToLog()，用 requestAnimationFrame 间隔统计帧时间，
+// 同时记录 long task，衡量消息日志渲染对主线程的占用。
+//
+//   npm install && node log_frame_bench.js [--data ../../data] [--rate 1000] [--duration 30] [--cpu 4]
+//                                          [--headless shell|new] [--json]
+//
+// --data 可指向另一份前端资源（例如从历史提交导出的旧版本），便于前后对比。
+'use strict';
+
+const http = require('http');
+const fs = require('fs');
+const path = require('path');
+const puppeteer = require('puppeteer');
+
+function parseArgs(argv) {
+  const options = {
+    data: path.resolve(__dirname, '../../data'),
+    rate: 1000,
+    duration: 30,
+    prefill: 1000,
+    cpu: 4,
+    headless: 'shell',
+    json: false,
+  };
+  for (let i = 2; i < argv.length; i += 1) {
+    const name = argv[i].replace(/^--/, '');
+    if (name === 'json') {
+      options.json = true;
+    } else if (name === 'data') {
+      options.data = path.resolve(argv[++i]);
+    } else if (name === 'headless') {
+      options.headless = argv[++i] === 'new' ? true : 'shell';
+    } else if (name in options) {
+      options[name] = Number(argv[++i]);
+    } else {
+      throw new Error(`unknown option ${argv[i]}`);
+    }
+  }
+  return options;
+}
+
+// 与固件 /api/schema 一致的夹具，由主机测试 bench_schema_test 校验，注册表改动后需同步更新。
+const schema = JSON.parse(fs.readFileSync(path.join(__dirname, 'schema.json'), 'utf8'));
+
+function fakeState() {
+  return {
+    wifi: { connected: true, ip: '192.168.4.1' },
+    node: 0,
+    nodes: [0],
+    stm32ReportedIp: '192.168.4.2',
+    uptimeSeconds: Math.floor(process.uptime()),
+    latestData: { temp: 25.3, humi: 54, soil: 42, lux: 350, water: 0, light: 1, fan: 0, buzzer: 0, ageMs: 800 },
+    latestRaw: { temp: 25.3, humi: 54, soil: 42, lux: 350 },
+    thresholds: { temp: null, humi: null, soil: 60, lux: null },
+    alarm: { count: 0, cooldownMs: 15000, pulseMs: 3000, reason: null, ageMs: null },
+  };
+}
+
+const contentTypes = { '.html': 'text/html', '.js': 'application/javascript', '.css': 'text/css' };
+
+function startServer(dataDir) {
+  const server = http.createServer((req, res) => {
+    const url = new URL(req.url, 'http://localhost');
+    if (url.pathname === '/api/schema') {
+      res.writeHead(200, { 'Content-Type': 'application/json' });
+      res.end(JSON.stringify(schema));
+    } else if (url.pathname === '/api/state') {
+      res.writeHead(200, { 'Content-Type': 'application/json' });
+      res.end(JSON.stringify(fakeState()));
+    } else if (url.pathname === '/api/messages') {
+      // 消息全部由基准脚本直接注入，轮询只返回空结果。
+      res.writeHead(200, { 'Content-Type': 'application/x-ndjson', 'X-Last-Message-Id': '0' });
+      res.end('');
+    } else {
+      const file = path.join(dataDir, url.pathname === '/' ? 'index.html' : path.normalize(url.pathname));
+      fs.readFile(file, (err, body) => {
+        if (err) {
+          res.writeHead(404);
+          res.end();
+          return;
+        }
+        res.writeHead(200, { 'Content-Type': contentTypes[path.extname(file)] || 'application/octet-stream' });
+        res.end(body);
+      });
+    }
+  });
+  return new Promise((resolve) => server.listen(0, '127.0.0.1', () => resolve(server)));
+}
+
+function percentile(sorted, p) {
+  if (sorted.length === 0) {
+    return 0;
+  }
+  return sorted[Math.min(sorted.length - 1, Math.floor((p / 100) * sorted.length))];
+}
+
+async function run(options) {
+  const server = await startServer(options.data);
+  const browser = await puppeteer.launch({ headless: options.headless, args: ['--no-sandbox'] });
+  try {
+    const page = await browser.newPage();
+    await page.setViewport({ width: 1280, height: 900 });
+    await page.goto(`http://127.0.0.1:${server.address().port}/`, { waitUntil: 'networkidle0' });
+    if (options.cpu > 1) {
+      await page.emulateCPUThrottling(options.cpu);
+    }
+
+    const result = await page.evaluate(
+      ({ rate, durationMs, prefill }) =>
+        new Promise((resolve) => {
+          let seq = 0;
+          const line = () => {
+            seq += 1;
+            return JSON.stringify({
+              type: 'data',
+              node: 0,
+              seq,
+              temp: 20 + (seq % 100) / 10,
+              humi: 50 + (seq % 7),
+              soil: 40 + (seq % 5),
+              lux: 300 + (seq % 50),
+              water: seq % 2,
+              light: 1,
+              fan: 0,
+              buzzer: 0,
+            });
+          };
+
+          const longTasks = [];
+          const observer = new PerformanceObserver((list) => {
+            list.getEntries().forEach((entry) => longTasks.push(entry.duration));
+          });
+          observer.observe({ entryTypes: ['longtask'] });
+
+          for (let i = 0; i < prefill; i += 1) {
+            appendMessageToLog(line());
+          }
+
+          // 等预填充的渲染完成后再开始计时。
+          requestAnimationFrame(() =>
+            requestAnimationFrame((startedAt) => {
+              longTasks.length = 0;
+              const frames = [];
+              let previous = startedAt;
+              const firstSeq = seq;
+              const timer = setInterval(() => appendMessageToLog(line()), 60000 / rate);
+              const tick = (now) => {
+                frames.push(now - previous);
+                previous = now;
+                if (now - startedAt < durationMs) {
+                  requestAnimationFrame(tick);
+                  return;
+                }
+                clearInterval(timer);
+                observer.disconnect();
+                resolve({ frames, longTasks, appended: seq - firstSeq });
+              };
+              requestAnimationFrame(tick);
+            }),
+          );
+        }),
+      { rate: options.rate, durationMs: options.duration * 1000, prefill: options.prefill },
+    );
+
+    const sorted = [...result.frames].sort((a, b) => a - b);
+    const mean = result.frames.reduce((sum, value) => sum + value, 0) / Math.max(1, result.frames.length);
+    return {
+      data: options.data,
+      rate: options.rate,
+      cpuThrottle: options.cpu,
+      durationS: options.duration,
+      appended: result.appended,
+      frames: result.frames.length,
+      meanMs: mean,
+      p50Ms: percentile(sorted, 50),
+      p95Ms: percentile(sorted, 95),
+      p99Ms: percentile(sorted, 99),
+      maxMs: sorted.length > 0 ? sorted[sorted.length - 1] : 0,
+      framesMissed: result.frames.filter((value) => value > 16.7 * 1.5).length,
+      framesOver50Ms: result.frames.filter((value) => value > 50).length,
+      longTasks: result.longTasks.length,
+      longTaskTotalMs: result.longTasks.reduce((sum, value) => sum + value, 0),
+    };
+  } finally {
+    await browser.close();
+    server.close();
+  }
+}
+
+run(parseArgs(process.argv))
+  .then((summary) => {
+    if (summary && process.argv.includes('--json')) {
+      console.log(JSON.stringify(summary, null, 2));
+      return;
+    }
+    console.log(`data:        ${summary.data}`);
+    console.log(`load:        ${summary.rate} msg/min for ${summary.durationS} s, CPU throttle x${summary.cpuThrottle}`);
+    console.log(`appended:    ${summary.appended} messages, ${summary.frames} frames`);
+    console.log(
+      `frame time:  mean ${summary.meanMs.toFixed(1)} ms, p50 ${summary.p50Ms.toFixed(1)} ms, ` +
+        `p95 ${summary.p95Ms.toFixed(1)} ms, p99 ${summary.p99Ms.toFixed(1)} ms, max ${summary.maxMs.toFixed(1)} ms`,
+    );
+    console.log(`dropped:     ${summary.framesMissed} frames > 1.5 vsync, ${summary.framesOver50Ms} frames > 50 ms`);
+    console.log(`long tasks:  ${summary.longTasks} (${summary.longTaskTotalMs.toFixed(0)} ms total)`);
+  })
+  .catch((error) => {
+    console.error(error);
+    process.exitCode = 1;
+  });
@@ -0,0 +1,39 @@
+// 原理说明：libFuzzer 入口，把任意字节按输入首字节决定的块长送入串口桥，经 handleSerialLine 落到消息日志与节点快照，
+// 随后读取几个 REST 接口，检查解析、环形缓冲与序列化路径在畸形输入下不越界、不崩溃。
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "serial_bridge.h"
+#include "web_server_module.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  static bool initialized = false;
+  if (!initialized) {
+    serial_bridge::begin(Serial, 115200);
+    serial_bridge::setMessageHandler(web_server_module::handleSerialLine);
+    web_server_module::start(80);
+    initialized = true;
+  }
+  if (size == 0) {
+    return 0;
+  }
+
+  const size_t chunk = static_cast<size_t>(data[0] % 64) + 1;
+  const char* bytes = reinterpret_cast<const char*>(data + 1);
+  const size_t length = size - 1;
+  for (size_t offset = 0; offset < length; offset += chunk) {
+    const size_t remaining = length - offset;
+    serial_bridge::feedBytes(bytes + offset, remaining < chunk ? remaining : chunk);
+    fake_clock::advance(data[0] & 0x0F);
+  }
+
+  ESP8266WebServer* server = ESP8266WebServer::instance();
+  server->request(HTTP_GET, "/api/messages");
+  server->request(HTTP_GET, "/api/messages?type=data,ack&node=0");
+  server->request(HTTP_GET, "/api/state");
+  server->request(HTTP_GET, "/api/stats");
+  return 0;
+}
@@ -0,0 +1,43 @@
+// 原理说明：没有 libFuzzer 时的替代入口，逐个读取命令行给出的文件或目录，把语料交给 LLVMFuzzerTestOneInput 回放一遍。
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+
+bool runFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    fprintf(stderr, "cannot open %s\n", path.string().c_str());
+    return false;
+  }
+  const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  LLVMFuzzerTestOneInput(bytes.data(), bytes.size());
+  printf("ok %s (%zu bytes)\n", path.string().c_str(), bytes.size());
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool ok = true;
+  for (int i = 1; i < argc; ++i) {
+    const std::filesystem::path path(argv[i]);
+    if (std::filesystem::is_directory(path)) {
+      for (const auto& entry : std::filesystem::directory_iterator(path)) {
+        if (entry.is_regular_file()) {
+          ok = runFile(entry.path()) && ok;
+        }
+      }
+    } else {
+      ok = runFile(path) && ok;
+    }
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+// 原理说明：前端基准用 test/bench/schema.json 伪造 /api/schema，这里把它与固件实际返回的 schema 逐字段比对，
+// 注册表改动后基准夹具不同步即失败，保证基准渲染的 DOM 与固件页面一致。
+#include <gtest/gtest.h>
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WebServer.h>
+
+#include <cmath>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+
+#include "web_server_module.h"
+
+namespace {
+
+void expectSameFields(JsonVariantConst expected,
+                      JsonVariantConst actual,
+                      std::initializer_list<const char*> text_keys,
+                      std::initializer_list<const char*> number_keys) {
+  for (const char* key : text_keys) {
+    ASSERT_TRUE(actual[key].is<const char*>()) << key;
+    EXPECT_STREQ(expected[key].as<const char*>(), actual[key].as<const char*>()) << key;
+  }
+  for (const char* key : number_keys) {
+    const double firmware_value = actual[key].as<double>();
+    // 注册表以 float 保存，夹具写的是十进制字面量，按相对误差比较。
+    EXPECT_NEAR(expected[key].as<double>(), firmware_value, 1e-6 * std::fmax(1.0, std::fabs(firmware_value)))
+        << key;
+  }
+}
+
+TEST(BenchSchemaTest, FixtureMatchesFirmwareSchema) {
+  std::ifstream file(std::string(SMARTPOT_BENCH_DIR) + "/schema.json", std::ios::binary);
+  ASSERT_TRUE(file) << "缺少 test/bench/schema.json";
+  const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  DynamicJsonDocument fixture(4096);
+  ASSERT_FALSE(deserializeJson(fixture, text));
+
+  web_server_module::start(80);
+  const FakeResponse& response = ESP8266WebServer::instance()->request(HTTP_GET, "/api/schema");
+  ASSERT_EQ(response.code, 200);
+  DynamicJsonDocument firmware(4096);
+  ASSERT_FALSE(deserializeJson(firmware, response.body));
+  SCOPED_TRACE(std::string("固件 /api/schema: ") + response.body.c_str());
+
+  const JsonDocument& want = fixture;
+  const JsonDocument& got = firmware;
+  ASSERT_EQ(want["metrics"].size(), got["metrics"].size());
+  for (size_t i = 0; i < got["metrics"].size(); ++i) {
+    SCOPED_TRACE(got["metrics"][i]["key"].as<const char*>());
+    expectSameFields(want["metrics"][i], got["metrics"][i], {"key", "label", "unit"}, {"decimals", "min", "max"});
+    expectSameFields(want["metrics"][i]["filter"], got["metrics"][i]["filter"], {},
+                     {"median", "emaAlpha", "maxRatePerS"});
+  }
+
+  ASSERT_EQ(want["actuators"].size(), got["actuators"].size());
+  for (size_t i = 0; i < got["actuators"].size(); ++i) {
+    expectSameFields(want["actuators"][i], got["actuators"][i], {"key", "label"}, {"maxPulseMs"});
+  }
+
+  ASSERT_EQ(want["actions"].size(), got["actions"].size());
+  for (size_t i = 0; i < got["actions"].size(); ++i) {
+    EXPECT_STREQ(want["actions"][i].as<const char*>(), got["actions"][i].as<const char*>());
+  }
+}
+
+}  // namespace
@@ -0,0 +1,110 @@
+// 原理说明：按协议第 7 节的时序构造 cmd → data → ack 交错场景，验证状态快照的可信判定、off 永不被拒绝以及令牌桶与合并行为。
+#include <gtest/gtest.h>
+
+#include "command_limiter.h"
+
+namespace {
+
+using command_limiter::Action;
+using command_limiter::Result;
+using command_limiter::TargetState;
+using command_limiter::Verdict;
+
+constexpr int kUnknown = -1;
+
+Result sendIfAllowed(TargetState& state, Action action, int switch_state, unsigned long updated_at, unsigned long now,
+                     uint32_t message_id) {
+  const Result result = command_limiter::evaluate(state, action, 0, switch_state, updated_at, now);
+  if (result.verdict == Verdict::kSend) {
+    command_limiter::markSent(state, action, 0, message_id, now);
+  }
+  return result;
+}
+
+TEST(CommandLimiterTest, SuppressesOnWhenFreshSnapshotAlreadyOn) {
+  TargetState state;
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOn, 0, 1, 500, 1000).verdict, Verdict::kSuppressed);
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOn, 0, 0, 500, 1000).verdict, Verdict::kSend);
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOn, 0, kUnknown, 0, 1000).verdict, Verdict::kSend);
+}
+
+TEST(CommandLimiterTest, NeverSuppressesOff) {
+  TargetState state;
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOff, 0, 0, 500, 1000).verdict, Verdict::kSend);
+}
+
+// 水泵刚被打开，下发后才到达、但在执行前采样的 data 帧仍显示 0；ack 之后用户点关闭必须下发。
+TEST(CommandLimiterTest, StaleFrameBetweenSendAndAckIsNotTrusted) {
+  TargetState state;
+  ASSERT_EQ(sendIfAllowed(state, Action::kOn, 0, 0, 1000, 1).verdict, Verdict::kSend);
+  const unsigned long stale_frame_at = 1100;
+  command_limiter::markAcked(state, 1200);
+
+  EXPECT_EQ(sendIfAllowed(state, Action::kOff, 0, stale_frame_at, 1300, 2).verdict, Verdict::kSend);
+}
+
+// 关闭命令超时未收到 ack，期间到达的 data 帧仍显示 1；再次开启不能因为这帧被判为“状态一致”。
+TEST(CommandLimiterTest, SnapshotAfterPendingTimeoutIsNotTrusted) {
+  TargetState state;
+  ASSERT_EQ(sendIfAllowed(state, Action::kOff, 1, 0, 1000, 1).verdict, Verdict::kSend);
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOn, 0, 1, 2000, 4500).verdict, Verdict::kSend);
+}
+
+TEST(CommandLimiterTest, SnapshotAfterAckIsTrusted) {
+  TargetState state;
+  ASSERT_EQ(sendIfAllowed(state, Action::kOn, 0, 0, 1000, 1).verdict, Verdict::kSend);
+  command_limiter::markAcked(state, 1200);
+
+  // 与 ack 同一毫秒的帧无法判断先后，按不可信处理。
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOn, 0, 1, 1200, 1300).verdict, Verdict::kSend);
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOn, 0, 1, 1250, 1300).verdict, Verdict::kSuppressed);
+}
+
+TEST(CommandLimiterTest, CoalescesDuplicatePendingCommand) {
+  TargetState state;
+  ASSERT_EQ(sendIfAllowed(state, Action::kOn, 0, 0, 1000, 7).verdict, Verdict::kSend);
+
+  const Result duplicate = command_limiter::evaluate(state, Action::kOn, 0, 0, 0, 1500);
+  EXPECT_EQ(duplicate.verdict, Verdict::kCoalesced);
+  EXPECT_EQ(duplicate.message_id, 7u);
+
+  // 待回执超时后不再合并。
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOn, 0, 0, 0, 4000).verdict, Verdict::kSend);
+}
+
+TEST(CommandLimiterTest, RateLimitsOnButNeverOff) {
+  TargetState state;
+  unsigned long now = 1000;
+  uint32_t id = 1;
+  for (int i = 0; i < command_limiter::kBucketCapacity; ++i) {
+    ASSERT_EQ(sendIfAllowed(state, Action::kOn, kUnknown, 0, now, id++).verdict, Verdict::kSend);
+    command_limiter::markAcked(state, now + 10);
+    ASSERT_EQ(sendIfAllowed(state, Action::kOff, kUnknown, 0, now + 20, id++).verdict, Verdict::kSend);
+    command_limiter::markAcked(state, now + 30);
+    now += 100;
+  }
+
+  const Result limited = command_limiter::evaluate(state, Action::kOn, 0, kUnknown, 0, now);
+  EXPECT_EQ(limited.verdict, Verdict::kRateLimited);
+  EXPECT_GT(limited.retry_after_ms, 0u);
+
+  EXPECT_EQ(sendIfAllowed(state, Action::kOff, kUnknown, 0, now, id++).verdict, Verdict::kSend);
+
+  // 补充一个令牌后恢复。
+  command_limiter::markAcked(state, now + 10);
+  EXPECT_EQ(command_limiter::evaluate(state, Action::kOn, 0, kUnknown, 0, 1000 + 1500).verdict, Verdict::kSend);
+}
+
+// 放行之后串口写入失败、未调用 markSent() 的命令不消耗令牌。
+TEST(CommandLimiterTest, FailedSendDoesNotConsumeToken) {
+  TargetState state;
+  for (int i = 0; i < command_limiter::kBucketCapacity * 2; ++i) {
+    ASSERT_EQ(command_limiter::evaluate(state, Action::kOn, 0, kUnknown, 0, 1000).verdict, Verdict::kSend);
+  }
+  EXPECT_EQ(state.tokens, command_limiter::kBucketCapacity);
+
+  command_limiter::markSent(state, Action::kOn, 0, 1, 1000);
+  EXPECT_EQ(state.tokens, command_limiter::kBucketCapacity - 1);
+}
+
+}  // namespace
@@ -0,0 +1,142 @@
+// 原理说明：网关模式下的节点表与消息日志：节点 0 启动即可用，只读接口探测未知节点与校验失败的写请求都不分配状态，
+// 一个节点高频上报时其他节点的保留份额不被挤出，跨节点查询仍按编号顺序返回。
+#include <gtest/gtest.h>
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WebServer.h>
+
+#include <string>
+#include <vector>
+
+#include "web_server_module.h"
+
+namespace {
+
+class GatewayNodesTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() { web_server_module::start(80); }
+
+  static const FakeResponse& get(const String& uri) {
+    return ESP8266WebServer::instance()->request(HTTP_GET, uri);
+  }
+
+  static uint32_t lastMessageId() {
+    return static_cast<uint32_t>(get("/api/messages?limit=1").headers.at("X-Last-Message-Id").toInt());
+  }
+
+  static std::vector<std::string> lines(const String& body) {
+    std::vector<std::string> result;
+    std::string rest = body.c_str();
+    size_t start = 0;
+    for (size_t end = rest.find('\n'); end != std::string::npos; end = rest.find('\n', start)) {
+      result.push_back(rest.substr(start, end - start));
+      start = end + 1;
+    }
+    return result;
+  }
+};
+
+TEST_F(GatewayNodesTest, NodeZeroIsAvailableBeforeFirstFrame) {
+  const FakeResponse& state = get("/api/state");
+  ASSERT_EQ(state.code, 200);
+  DynamicJsonDocument doc(4096);
+  ASSERT_FALSE(deserializeJson(doc, state.body));
+  const JsonDocument& view = doc;
+  EXPECT_FALSE(view["thresholds"].isNull());
+  EXPECT_FALSE(view["alarm"].isNull());
+  EXPECT_EQ(get("/api/thresholds").code, 200);
+}
+
+TEST_F(GatewayNodesTest, ReadOnlyRoutesDoNotAllocateUnknownNodes) {
+  EXPECT_EQ(get("/api/stats?node=7").code, 404);
+  EXPECT_EQ(get("/api/thresholds?node=7").code, 404);
+
+  const FakeResponse& messages = get("/api/messages?node=7");
+  EXPECT_EQ(messages.code, 200);
+  EXPECT_EQ(messages.body.length(), 0u);
+
+  // 未知节点的 /api/state 仍返回网关级字段，节点级字段为 null。
+  for (int i = 0; i < 2; ++i) {
+    const FakeResponse& state = get("/api/state?node=7");
+    ASSERT_EQ(state.code, 200);
+    DynamicJsonDocument doc(4096);
+    ASSERT_FALSE(deserializeJson(doc, state.body));
+    const JsonDocument& view = doc;
+    EXPECT_EQ(view["node"].as<int>(), 7);
+    EXPECT_TRUE(view["thresholds"].isNull());
+    EXPECT_TRUE(view["alarm"].isNull());
+    EXPECT_TRUE(view["latestData"].isNull());
+    EXPECT_FALSE(view["serialLink"].isNull());
+    EXPECT_FALSE(view["power"].isNull());
+    EXPECT_FALSE(view["nodes"].isNull());
+  }
+  // 重复探测后阈值接口仍为 404，说明上面的请求没有分配节点。
+  EXPECT_EQ(get("/api/thresholds?node=7").code, 404);
+  EXPECT_EQ(get("/api/state?node=9").code, 400);
+}
+
+TEST_F(GatewayNodesTest, RejectedWritesDoNotAllocateNodes) {
+  ESP8266WebServer* web = ESP8266WebServer::instance();
+  EXPECT_EQ(web->request(HTTP_POST, "/api/thresholds?node=6", "{\"soil\":").code, 400);
+  EXPECT_EQ(web->request(HTTP_POST, "/api/thresholds?node=6", "{\"soil\":\"wet\"}").code, 422);
+  EXPECT_EQ(web->request(HTTP_POST, "/api/thresholds?node=6", "{}").code, 422);
+  EXPECT_EQ(web->request(HTTP_POST, "/api/cmd", "{\"node\":6,\"target\":\"pump\",\"action\":\"on\"}").code, 422);
+  EXPECT_EQ(get("/api/thresholds?node=6").code, 404);
+
+  const FakeResponse& post = web->request(HTTP_POST, "/api/thresholds?node=6", "{\"soil\":60}");
+  EXPECT_EQ(post.code, 200) << post.body.c_str();
+  EXPECT_EQ(get("/api/thresholds?node=6").code, 200);
+}
+
+TEST_F(GatewayNodesTest, BusyNodeDoesNotEvictQuietNodeAck) {
+  const uint32_t ack_id = lastMessageId() + 1;
+  const String ack = "{\"type\":\"ack\",\"node\":1,\"target\":\"water\",\"action\":\"on\",\"result\":\"ok\"}";
+  web_server_module::handleSerialLine(ack);
+  for (int i = 0; i < 200; ++i) {
+    web_server_module::handleSerialLine(String("{\"type\":\"data\",\"node\":0,\"temp\":") + String(20 + i % 5) + "}");
+  }
+
+  const std::vector<std::string> node_acks = lines(get("/api/messages?node=1&type=ack").body);
+  ASSERT_EQ(node_acks.size(), 1u);
+  EXPECT_EQ(node_acks[0], ack.c_str());
+
+  const std::vector<std::string> global_acks = lines(get("/api/messages?type=ack").body);
+  ASSERT_EQ(global_acks.size(), 1u);
+  EXPECT_EQ(global_acks[0], ack.c_str());
+
+  const FakeResponse& by_id = get(String("/api/messages/") + String(ack_id));
+  EXPECT_EQ(by_id.code, 200);
+  EXPECT_STREQ(by_id.headers.at("X-Node-Id").c_str(), "1");
+
+  // 48 个槽位中节点 1 占 1 条，其余由节点 0 滚动使用。
+  EXPECT_EQ(lines(get("/api/messages?node=0").body).size(), 47u);
+  EXPECT_EQ(lines(get("/api/messages").body).size(), 48u);
+}
+
+TEST_F(GatewayNodesTest, MergedQueryKeepsArrivalOrder) {
+  const uint32_t after = lastMessageId();
+  const std::vector<std::string> sent = {
+      "{\"type\":\"data\",\"node\":2,\"temp\":21}",
+      "not json",
+      "{\"type\":\"ack\",\"node\":3,\"target\":\"fan\",\"action\":\"off\",\"result\":\"ok\"}",
+      "{\"type\":\"data\",\"node\":3,\"temp\":22}",
+      "{\"type\":\"status\",\"node\":2,\"ip\":\"192.168.4.2\"}",
+  };
+  for (const std::string& line : sent) {
+    web_server_module::handleSerialLine(String(line.c_str()));
+  }
+
+  EXPECT_EQ(lines(get(String("/api/messages?after=") + String(after)).body), sent);
+
+  const std::vector<std::string> node3 = lines(get(String("/api/messages?node=3&after=") + String(after)).body);
+  ASSERT_EQ(node3.size(), 2u);
+  EXPECT_EQ(node3[0], sent[2]);
+  EXPECT_EQ(node3[1], sent[3]);
+
+  const std::vector<std::string> older = lines(get(String("/api/messages?before=") + String(after + 3)).body);
+  ASSERT_FALSE(older.empty());
+  EXPECT_EQ(older.back(), sent[1]);
+}
+
+}  // namespace
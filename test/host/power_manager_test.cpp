@@ -0,0 +1,149 @@
+// 原理说明：power_manager 只依赖传入的时间戳，直接用模拟时钟逐毫秒推进，验证空闲进入、串口唤醒保持与模式切换边沿。
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "power_manager.h"
+
+namespace {
+
+using power_manager::Decision;
+using power_manager::Mode;
+
+class PowerManagerTest : public ::testing::Test {
+ protected:
+  void begin(unsigned long now) {
+    now_ = now;
+    power_manager::begin(now_);
+  }
+
+  Decision step(unsigned long advance_ms, uint8_t stations, bool uart = false) {
+    now_ += advance_ms;
+    return power_manager::update(now_, stations, uart);
+  }
+
+  // 推进到空闲模式，返回进入空闲那一轮的决策。
+  Decision enterIdle() {
+    step(29999, 0);
+    return step(1, 0);
+  }
+
+  unsigned long now_ = 0;
+};
+
+TEST_F(PowerManagerTest, StartsActiveWithFastPolling) {
+  begin(1000);
+  const Decision decision = step(10, 0);
+  EXPECT_EQ(decision.mode, Mode::kActive);
+  EXPECT_FALSE(decision.mode_changed);
+  EXPECT_EQ(decision.poll_delay_ms, 10);
+  EXPECT_EQ(power_manager::reportIntervalSeconds(decision.mode), 5);
+}
+
+TEST_F(PowerManagerTest, EntersIdleExactlyThirtySecondsAfterLastClient) {
+  begin(0);
+  step(5000, 1);
+
+  Decision decision = step(29999, 0);
+  EXPECT_EQ(decision.mode, Mode::kActive);
+  EXPECT_FALSE(decision.mode_changed);
+
+  decision = step(1, 0);
+  EXPECT_EQ(decision.mode, Mode::kIdle);
+  EXPECT_TRUE(decision.mode_changed);
+  EXPECT_EQ(decision.poll_delay_ms, 50);
+  EXPECT_EQ(power_manager::reportIntervalSeconds(decision.mode), 30);
+
+  // 切换只在边沿上报告一次。
+  decision = step(50, 0);
+  EXPECT_EQ(decision.mode, Mode::kIdle);
+  EXPECT_FALSE(decision.mode_changed);
+}
+
+TEST_F(PowerManagerTest, ConnectedClientKeepsActive) {
+  begin(0);
+  for (int i = 0; i < 1000; ++i) {
+    const Decision decision = step(100, 1);
+    ASSERT_EQ(decision.mode, Mode::kActive);
+    ASSERT_FALSE(decision.mode_changed);
+  }
+}
+
+TEST_F(PowerManagerTest, ClientReturningLeavesIdleImmediately) {
+  begin(0);
+  ASSERT_TRUE(enterIdle().mode_changed);
+
+  Decision decision = step(10, 1);
+  EXPECT_EQ(decision.mode, Mode::kActive);
+  EXPECT_TRUE(decision.mode_changed);
+  EXPECT_EQ(decision.poll_delay_ms, 10);
+
+  // 客户端离开后重新计时，而不是沿用第一次的时间戳。
+  decision = step(29999, 0);
+  EXPECT_EQ(decision.mode, Mode::kActive);
+  decision = step(1, 0);
+  EXPECT_EQ(decision.mode, Mode::kIdle);
+  EXPECT_TRUE(decision.mode_changed);
+}
+
+TEST_F(PowerManagerTest, UartActivityHoldsFastPollingFor200ms) {
+  begin(0);
+  enterIdle();
+
+  Decision decision = step(50, 0, true);
+  EXPECT_EQ(decision.mode, Mode::kIdle);
+  EXPECT_FALSE(decision.mode_changed);
+  EXPECT_EQ(decision.poll_delay_ms, 10);
+
+  decision = step(199, 0);
+  EXPECT_EQ(decision.poll_delay_ms, 10);
+
+  decision = step(1, 0);
+  EXPECT_EQ(decision.mode, Mode::kIdle);
+  EXPECT_EQ(decision.poll_delay_ms, 50);
+}
+
+TEST_F(PowerManagerTest, RepeatedUartActivityExtendsHold) {
+  begin(0);
+  enterIdle();
+
+  step(10, 0, true);
+  step(150, 0, true);
+  EXPECT_EQ(step(199, 0).poll_delay_ms, 10);
+  EXPECT_EQ(step(1, 0).poll_delay_ms, 50);
+}
+
+// UART 活动不影响模式本身，也不会阻止进入空闲。
+TEST_F(PowerManagerTest, UartActivityDoesNotPreventIdleEntry) {
+  begin(0);
+  for (int i = 0; i < 299; ++i) {
+    ASSERT_EQ(step(100, 0, true).mode, Mode::kActive);
+  }
+  const Decision decision = step(100, 0, true);
+  EXPECT_EQ(decision.mode, Mode::kIdle);
+  EXPECT_TRUE(decision.mode_changed);
+  EXPECT_EQ(decision.poll_delay_ms, 10);
+}
+
+TEST_F(PowerManagerTest, SurvivesMillisWraparound) {
+  begin(std::numeric_limits<unsigned long>::max() - 10000);
+  Decision decision = step(29999, 0);
+  EXPECT_EQ(decision.mode, Mode::kActive);
+  decision = step(1, 0);
+  EXPECT_EQ(decision.mode, Mode::kIdle);
+  EXPECT_TRUE(decision.mode_changed);
+}
+
+TEST_F(PowerManagerTest, DutyCycleCoversTenSecondWindow) {
+  begin(0);
+  EXPECT_FLOAT_EQ(power_manager::dutyCycle(), 1.0f);
+  for (int i = 0; i < 999; ++i) {
+    power_manager::recordLoop(1000, 9000);
+  }
+  // 窗口未满前保持上一次的结果。
+  EXPECT_FLOAT_EQ(power_manager::dutyCycle(), 1.0f);
+  power_manager::recordLoop(1000, 9000);
+  EXPECT_NEAR(power_manager::dutyCycle(), 0.1f, 1e-4f);
+}
+
+}  // namespace
@@ -0,0 +1,128 @@
+// 原理说明：用 traces/ 中录制的含尖峰噪声的传感器序列驱动 sensor_filter，参数取自 device_registry 的实际配置，
+// 断言原始值越过报警阈值而滤波值不越过；另用阶跃序列确认真实变化仍能在几个采样内触发。
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "device_registry.h"
+#include "sensor_filter.h"
+
+namespace {
+
+struct Sample {
+  unsigned long ms;
+  float raw;
+};
+
+std::vector<Sample> loadTrace(const char* name) {
+  std::vector<Sample> samples;
+  std::ifstream file(std::string(SMARTPOT_TRACE_DIR) + "/" + name);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#' || line[0] == 'm') {
+      continue;
+    }
+    std::istringstream fields(line);
+    Sample sample{};
+    char comma = 0;
+    fields >> sample.ms >> comma >> sample.raw;
+    samples.push_back(sample);
+  }
+  return samples;
+}
+
+const sensor_filter::FilterSpec& filterFor(const char* key) {
+  const int index = device_registry::findMetric(key);
+  EXPECT_NE(index, device_registry::kNotFound) << key;
+  return device_registry::kMetrics[index].filter;
+}
+
+struct TraceResult {
+  float max_raw = 0.0f;
+  float max_filtered = 0.0f;
+  float min_filtered = 0.0f;
+};
+
+TraceResult runTrace(const char* key, const std::vector<Sample>& samples) {
+  const sensor_filter::FilterSpec& spec = filterFor(key);
+  sensor_filter::FilterState state;
+  TraceResult result;
+  bool first = true;
+  for (const Sample& sample : samples) {
+    const float filtered = sensor_filter::apply(state, spec, sample.raw, sample.ms);
+    if (first) {
+      result.max_raw = sample.raw;
+      result.max_filtered = result.min_filtered = filtered;
+      first = false;
+    }
+    result.max_raw = sample.raw > result.max_raw ? sample.raw : result.max_raw;
+    result.max_filtered = filtered > result.max_filtered ? filtered : result.max_filtered;
+    result.min_filtered = filtered < result.min_filtered ? filtered : result.min_filtered;
+  }
+  return result;
+}
+
+// 报警条件与 web_server_module 一致：滤波值严格大于阈值。
+TEST(SensorFilterTraceTest, SoilSpikesDoNotCrossAlarmThreshold) {
+  const std::vector<Sample> samples = loadTrace("soil_spikes.csv");
+  ASSERT_EQ(samples.size(), 120u);
+  constexpr float kThreshold = 60.0f;
+
+  const TraceResult result = runTrace("soil", samples);
+  EXPECT_GT(result.max_raw, kThreshold);
+  EXPECT_LE(result.max_filtered, kThreshold);
+  EXPECT_LT(result.max_filtered, 45.0f);
+  EXPECT_GT(result.min_filtered, 35.0f);
+}
+
+TEST(SensorFilterTraceTest, LuxSpikesDoNotCrossAlarmThreshold) {
+  const std::vector<Sample> samples = loadTrace("lux_spikes.csv");
+  ASSERT_EQ(samples.size(), 110u);
+  constexpr float kThreshold = 1000.0f;
+
+  const TraceResult result = runTrace("lux", samples);
+  EXPECT_GT(result.max_raw, kThreshold);
+  EXPECT_LE(result.max_filtered, kThreshold);
+  EXPECT_LT(result.max_filtered, 520.0f);
+  EXPECT_GT(result.min_filtered, 250.0f);
+}
+
+// 浇水后土壤湿度从 40% 跳到 70% 并保持，滤波值应在 5 个采样（25 s）内越过 60% 阈值。
+TEST(SensorFilterTraceTest, GenuineStepStillTriggersQuickly) {
+  const sensor_filter::FilterSpec& spec = filterFor("soil");
+  sensor_filter::FilterState state;
+  unsigned long now = 0;
+  for (int i = 0; i < 20; ++i, now += 5000) {
+    sensor_filter::apply(state, spec, 40.0f, now);
+  }
+
+  int samples_to_alarm = 0;
+  float filtered = 0.0f;
+  while (filtered <= 60.0f && samples_to_alarm < 20) {
+    filtered = sensor_filter::apply(state, spec, 70.0f, now);
+    now += 5000;
+    ++samples_to_alarm;
+  }
+  EXPECT_LE(samples_to_alarm, 5);
+}
+
+TEST(SensorFilterTest, NanPassesThroughWithoutTouchingState) {
+  const sensor_filter::FilterSpec& spec = filterFor("temp");
+  sensor_filter::FilterState state;
+  sensor_filter::apply(state, spec, 25.0f, 0);
+  EXPECT_TRUE(isnan(sensor_filter::apply(state, spec, NAN, 5000)));
+  EXPECT_FLOAT_EQ(sensor_filter::apply(state, spec, 25.0f, 10000), 25.0f);
+}
+
+TEST(SensorFilterTest, RateLimitBoundsStepPerSecond) {
+  const sensor_filter::FilterSpec spec{1, 1.0f, 2.0f};
+  sensor_filter::FilterState state;
+  sensor_filter::apply(state, spec, 20.0f, 0);
+  EXPECT_FLOAT_EQ(sensor_filter::apply(state, spec, 40.0f, 5000), 30.0f);
+  EXPECT_FLOAT_EQ(sensor_filter::apply(state, spec, 40.0f, 10000), 40.0f);
+}
+
+}  // namespace
@@ -0,0 +1,79 @@
+// 原理说明：回放逻辑使用固定种子的伪随机数，同一组参数每次运行得到相同的分块方式，失败可稳定复现。
+#include "serial_replay.h"
+
+#include <Arduino.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#include "serial_bridge.h"
+
+namespace serial_replay {
+namespace {
+
+unsigned long readEnvironment(const char* name, unsigned long fallback) {
+  const char* value = getenv(name);
+  if (value == nullptr || value[0] == '\0') {
+    return fallback;
+  }
+  return strtoul(value, nullptr, 10);
+}
+
+}  // namespace
+
+Options optionsFromEnvironment(const Options& defaults) {
+  Options options = defaults;
+  options.max_chunk = readEnvironment("SERIAL_REPLAY_CHUNK", options.max_chunk);
+  options.jitter_ms = readEnvironment("SERIAL_REPLAY_JITTER_MS", options.jitter_ms);
+  options.baud = readEnvironment("SERIAL_REPLAY_BAUD", options.baud);
+  options.seed = static_cast<uint32_t>(readEnvironment("SERIAL_REPLAY_SEED", options.seed));
+  if (options.max_chunk == 0) {
+    options.max_chunk = 1;
+  }
+  if (options.min_chunk == 0 || options.min_chunk > options.max_chunk) {
+    options.min_chunk = 1;
+  }
+  if (options.baud == 0) {
+    options.baud = defaults.baud;
+  }
+  return options;
+}
+
+bool loadCapture(const char* name, std::string& bytes) {
+  std::ifstream file(std::string(SMARTPOT_CAPTURE_DIR) + "/" + name, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+size_t replay(const std::string& bytes, const Options& options) {
+  std::mt19937 rng(options.seed);
+  std::uniform_int_distribution<size_t> chunk_length(options.min_chunk, options.max_chunk);
+  std::uniform_int_distribution<unsigned long> jitter(0, options.jitter_ms);
+
+  const size_t overflowed_before = Serial.overflowedBytes();
+  // 按累计位数折算线路时间，不足 1 ms 的部分留到下一块，避免逐块取整丢失。
+  unsigned long long wire_bits = 0;
+  unsigned long wire_ms = 0;
+  size_t offset = 0;
+  while (offset < bytes.size()) {
+    size_t length = chunk_length(rng);
+    if (length > bytes.size() - offset) {
+      length = bytes.size() - offset;
+    }
+    Serial.inject(bytes.data() + offset, length);
+    offset += length;
+    wire_bits += static_cast<unsigned long long>(length) * 10ULL;
+    const unsigned long elapsed_ms = static_cast<unsigned long>(wire_bits * 1000ULL / options.baud);
+    fake_clock::advance(elapsed_ms - wire_ms + jitter(rng));
+    wire_ms = elapsed_ms;
+    serial_bridge::loop();
+  }
+  return Serial.overflowedBytes() - overflowed_before;
+}
+
+}  // namespace serial_replay
@@ -0,0 +1,28 @@
+// 原理说明：串口回放工具把抓包文件按随机块长、随机间隔注入串口替身，复现 UART 分段到达与主循环调度抖动；
+// 模拟时钟按线路字节时间（10 bit/字节）推进，单块超过接收缓冲时多出的字节按硬件行为溢出丢弃。
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace serial_replay {
+
+struct Options {
+  size_t min_chunk = 1;         // 每次注入的最小字节数
+  size_t max_chunk = 64;        // 每次注入的最大字节数，实际块长在 [min_chunk, max_chunk] 内随机
+  unsigned long jitter_ms = 0;  // 两次 loop() 之间推进时钟的最大毫秒数
+  unsigned long baud = 115200;  // 线路波特率，决定每块字节到达所占的时间
+  uint32_t seed = 1;
+};
+
+// 环境变量 SERIAL_REPLAY_CHUNK / SERIAL_REPLAY_JITTER_MS / SERIAL_REPLAY_BAUD / SERIAL_REPLAY_SEED 可覆盖默认值。
+Options optionsFromEnvironment(const Options& defaults);
+
+// 读取 captures/ 目录下的抓包文件，按字节原样返回。
+bool loadCapture(const char* name, std::string& bytes);
+
+// 注入全部字节，每注入一块推进时钟并调用一次 serial_bridge::loop()；返回因接收缓冲溢出丢弃的字节数。
+size_t replay(const std::string& bytes, const Options& options);
+
+}  // namespace serial_replay
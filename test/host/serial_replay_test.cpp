@@ -0,0 +1,222 @@
+// 原理说明：把 captures/ 中的抓包按不同块长、抖动与波特率回放进串口桥，断言链路计数、/api/state 暴露的节点快照
+// 以及行组装的 String 分配次数；每个抓包使用独立节点号，模块状态在同一进程内累积，断言均以回放前后的差值计算。
+#include <gtest/gtest.h>
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ESP8266WebServer.h>
+
+#include <ostream>
+#include <string>
+
+#include "serial_bridge.h"
+#include "serial_replay.h"
+#include "web_server_module.h"
+
+namespace {
+
+struct ReplayParam {
+  size_t max_chunk;
+  unsigned long jitter_ms;
+  unsigned long baud;
+};
+
+void PrintTo(const ReplayParam& param, std::ostream* os) {
+  *os << "chunk<=" << param.max_chunk << " jitter<=" << param.jitter_ms << "ms " << param.baud << "bd";
+}
+
+void startBridge() {
+  serial_bridge::begin(Serial, 115200);
+  serial_bridge::setMessageHandler(web_server_module::handleSerialLine);
+  web_server_module::start(80);
+}
+
+class SerialLinkTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() { startBridge(); }
+
+  void SetUp() override {
+    before_ = serial_bridge::stats();
+    before_message_id_ = lastMessageId();
+  }
+
+  uint32_t delivered() const { return serial_bridge::stats().frames_delivered - before_.frames_delivered; }
+  uint32_t dropped() const { return serial_bridge::stats().frames_dropped - before_.frames_dropped; }
+  uint32_t overruns() const { return serial_bridge::stats().rx_overruns - before_.rx_overruns; }
+  uint32_t logged() const { return lastMessageId() - before_message_id_; }
+
+  static uint32_t lastMessageId() {
+    const FakeResponse& response = ESP8266WebServer::instance()->request(HTTP_GET, "/api/messages?limit=1");
+    return static_cast<uint32_t>(response.headers.at("X-Last-Message-Id").toInt());
+  }
+
+  static void loadState(uint8_t node, JsonDocument& doc) {
+    const FakeResponse& response =
+        ESP8266WebServer::instance()->request(HTTP_GET, String("/api/state?node=") + String(node));
+    ASSERT_EQ(response.code, 200) << response.body.c_str();
+    ASSERT_FALSE(deserializeJson(doc, response.body));
+  }
+
+  serial_bridge::LinkStats before_;
+  uint32_t before_message_id_ = 0;
+};
+
+class SerialReplayTest : public SerialLinkTest, public ::testing::WithParamInterface<ReplayParam> {
+ protected:
+  // 按参数回放抓包；参数内的块长都不超过接收缓冲，回放不应触发溢出。
+  void replay(const char* capture) {
+    std::string bytes;
+    ASSERT_TRUE(serial_replay::loadCapture(capture, bytes)) << capture;
+    serial_replay::Options defaults;
+    defaults.max_chunk = GetParam().max_chunk;
+    defaults.jitter_ms = GetParam().jitter_ms;
+    defaults.baud = GetParam().baud;
+    options_ = serial_replay::optionsFromEnvironment(defaults);
+    replayed_bytes_ += bytes.size();
+    EXPECT_EQ(serial_replay::replay(bytes, options_), 0u) << capture << " 回放时接收缓冲溢出";
+  }
+
+  serial_replay::Options options_;
+  size_t replayed_bytes_ = 0;
+};
+
+TEST_P(SerialReplayTest, BasicSessionUpdatesSnapshot) {
+  const unsigned long started_ms = millis();
+  replay("basic_session.ndjson");
+
+  // 时钟至少推进了全部字节在线路上的传输时间。
+  EXPECT_GE(millis() - started_ms, replayed_bytes_ * 10000 / options_.baud);
+
+  EXPECT_EQ(delivered(), 5u);
+  EXPECT_EQ(dropped(), 0u);
+  EXPECT_EQ(logged(), 5u);
+
+  DynamicJsonDocument state(4096);
+  loadState(0, state);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["temp"].as<float>(), 25.3f);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["soil"].as<float>(), 42.0f);
+  EXPECT_EQ(state["latestData"]["water"].as<int>(), 1);
+  EXPECT_EQ(state["latestData"]["light"].as<int>(), 1);
+  EXPECT_STREQ(state["latestAck"]["target"].as<const char*>(), "light");
+  EXPECT_STREQ(state["latestAck"]["result"].as<const char*>(), "ok");
+  EXPECT_STREQ(state["stm32ReportedIp"].as<const char*>(), "192.168.4.1");
+}
+
+// 空行不计帧；行内孤立的 CR 被剔除，"\r\r\n" 与 "\r\n" 等价。
+TEST_P(SerialReplayTest, CrlfMixDeliversEveryNonEmptyLine) {
+  replay("crlf_mix.ndjson");
+
+  EXPECT_EQ(delivered(), 4u);
+  EXPECT_EQ(dropped(), 0u);
+
+  DynamicJsonDocument state(4096);
+  loadState(1, state);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["temp"].as<float>(), 21.5f);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["humi"].as<float>(), 62.0f);
+  EXPECT_EQ(state["latestData"]["fan"].as<int>(), 1);
+  EXPECT_STREQ(state["latestAck"]["target"].as<const char*>(), "fan");
+}
+
+// 600 字节的行整行丢弃且残余片段不会被当作新帧；恰好 512 字节的行仍然转发。
+TEST_P(SerialReplayTest, OverlongLineIsDroppedWithoutCorruptingNeighbours) {
+  replay("overlong_line.ndjson");
+
+  EXPECT_EQ(delivered(), 3u);
+  EXPECT_EQ(dropped(), 1u);
+  EXPECT_EQ(logged(), 3u);
+  EXPECT_GE(serial_bridge::stats().longest_line, 512u);
+
+  DynamicJsonDocument state(4096);
+  loadState(2, state);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["temp"].as<float>(), 18.5f);
+}
+
+// 串口桥不校验编码，非法 UTF-8 的行照常转发并记入日志，后续合法帧不受影响。
+TEST_P(SerialReplayTest, InvalidUtf8DoesNotDisturbFollowingFrames) {
+  replay("invalid_utf8.ndjson");
+
+  EXPECT_EQ(delivered(), 4u);
+  EXPECT_EQ(dropped(), 0u);
+  EXPECT_EQ(logged(), 4u);
+
+  DynamicJsonDocument state(4096);
+  loadState(3, state);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["temp"].as<float>(), 22.2f);
+  EXPECT_EQ(state["latestData"]["buzzer"].as<int>(), 1);
+
+  const FakeResponse& messages = ESP8266WebServer::instance()->request(HTTP_GET, "/api/messages?limit=4");
+  EXPECT_EQ(messages.code, 200);
+}
+
+// 缺少换行的尾帧留在缓冲中，直到下一段数据补上换行才转发。
+TEST_P(SerialReplayTest, PartialTailCompletesOnNextNewline) {
+  replay("partial_tail.ndjson");
+
+  EXPECT_EQ(delivered(), 1u);
+  DynamicJsonDocument state(4096);
+  loadState(4, state);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["temp"].as<float>(), 23.0f);
+
+  serial_bridge::feedBytes("\n", 1);
+  EXPECT_EQ(delivered(), 2u);
+  EXPECT_EQ(dropped(), 0u);
+  state.clear();
+  loadState(4, state);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["temp"].as<float>(), 23.5f);
+}
+
+// rx_buffer 在 begin() 中预留整行容量，行组装不应随分段到达反复扩容：每条组装出的行至多一次分配。
+TEST_P(SerialReplayTest, LineAssemblyAllocatesAtMostOncePerLine) {
+  serial_bridge::setMessageHandler([](const String&) {});
+  const uint32_t allocations_before = String::allocationCount();
+  replay("overlong_line.ndjson");
+  replay("basic_session.ndjson");
+  const uint32_t allocations = String::allocationCount() - allocations_before;
+  serial_bridge::setMessageHandler(web_server_module::handleSerialLine);
+
+  EXPECT_EQ(delivered(), 8u);
+  EXPECT_LE(allocations, delivered());
+}
+
+INSTANTIATE_TEST_SUITE_P(ChunkingJitterAndBaud,
+                         SerialReplayTest,
+                         ::testing::Values(ReplayParam{1, 0, 115200},
+                                           ReplayParam{7, 3, 9600},
+                                           ReplayParam{64, 20, 115200},
+                                           ReplayParam{1024, 0, 115200}),
+                         [](const ::testing::TestParamInfo<ReplayParam>& info) {
+                           return "chunk" + std::to_string(info.param.max_chunk) + "_jitter" +
+                                  std::to_string(info.param.jitter_ms) + "_baud" +
+                                  std::to_string(info.param.baud);
+                         });
+
+// 一次到达的突发超过 1 KiB 接收缓冲：多出的字节被硬件丢弃并计入溢出，缓冲内完整的行照常转发。
+// 缓冲末尾的半行会与溢出后到达的下一行拼成一条无效帧，再下一行起恢复正常。
+TEST_F(SerialLinkTest, BurstBeyondRxBufferOverflowsAndRecovers) {
+  std::string burst;
+  for (int i = 0; i < 30; ++i) {
+    burst += "{\"type\":\"data\",\"node\":5,\"temp\":" + std::to_string(20 + i % 10) +
+             ",\"humi\":55,\"soil\":41,\"lux\":320,\"water\":0,\"light\":0,\"fan\":0,\"buzzer\":0}\n";
+  }
+  ASSERT_GT(burst.size(), Serial.rxBufferSize());
+
+  serial_replay::Options options;
+  options.min_chunk = burst.size();
+  options.max_chunk = burst.size();
+  const size_t overflowed = serial_replay::replay(burst, options);
+
+  EXPECT_EQ(overflowed, burst.size() - Serial.rxBufferSize());
+  EXPECT_EQ(overruns(), 1u);
+  EXPECT_EQ(delivered(), Serial.rxBufferSize() / (burst.size() / 30));
+
+  const std::string tail = "{\"type\":\"data\",\"node\":5,\"temp\":31.5}\n{\"type\":\"data\",\"node\":5,\"temp\":32.5}\n";
+  serial_replay::replay(tail, options);
+  EXPECT_EQ(overruns(), 1u);
+
+  DynamicJsonDocument state(4096);
+  loadState(5, state);
+  EXPECT_FLOAT_EQ(state["latestRaw"]["temp"].as<float>(), 32.5f);
+  EXPECT_EQ(state["serialLink"]["overruns"].as<uint32_t>(), serial_bridge::stats().rx_overruns);
+}
+
+}  // namespace
@@ -0,0 +1,35 @@
+// 原理说明：主机测试用的 Arduino 核心替身，时钟由测试驱动，使依赖 millis() 的模块可以在 PC 上确定性地复现。
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "HardwareSerial.h"
+#include "IPAddress.h"
+#include "Print.h"
+#include "Stream.h"
+#include "WString.h"
+
+using std::isnan;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+class EspClass {
+ public:
+  uint32_t getFreeHeap() const { return free_heap; }
+  uint32_t free_heap = 40000;
+};
+
+extern EspClass ESP;
+
+// 测试专用的模拟时钟，delay() 同样推进该时钟。
+namespace fake_clock {
+void set(unsigned long ms);
+void advance(unsigned long ms);
+}  // namespace fake_clock
@@ -0,0 +1,78 @@
+// 原理说明：主机测试用的 Web 服务器替身，按注册顺序匹配处理器，请求由测试直接注入并记录响应内容。
+#pragma once
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <Arduino.h>
+#include <FS.h>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+class ESP8266WebServer;
+
+class RequestHandler {
+ public:
+  virtual ~RequestHandler() = default;
+  virtual bool canHandle(HTTPMethod method, const String& uri) = 0;
+  virtual bool canUpload(const String& uri) = 0;
+  virtual bool handle(ESP8266WebServer& server, HTTPMethod method, const String& uri) = 0;
+};
+
+struct FakeResponse {
+  int code = 0;
+  String content_type;
+  String body;
+  std::map<std::string, String> headers;
+};
+
+class ESP8266WebServer {
+ public:
+  using THandlerFunction = std::function<void()>;
+
+  explicit ESP8266WebServer(uint16_t port);
+  ~ESP8266WebServer();
+
+  void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+  void on(const String& uri, HTTPMethod method, THandlerFunction handler);
+  void addHandler(RequestHandler* handler) { handlers_.push_back({String(), HTTP_ANY, nullptr, handler}); }
+  void onNotFound(THandlerFunction handler) { not_found_ = handler; }
+  void begin() { running_ = true; }
+  void stop() { running_ = false; }
+  void handleClient() {}
+
+  const String& uri() const { return uri_; }
+  HTTPMethod method() const { return method_; }
+  bool hasArg(const String& name) const { return args_.count(name.str()) != 0; }
+  String arg(const String& name) const {
+    const auto it = args_.find(name.str());
+    return it != args_.end() ? it->second : String();
+  }
+
+  void sendHeader(const String& name, const String& value) { pending_headers_[name.str()] = value; }
+  void send(int code, const char* content_type, const String& content);
+  size_t streamFile(File& file, const String& content_type);
+
+  // 测试接口：注入一次请求，uri 可带查询串，body 对应 "plain" 参数。
+  const FakeResponse& request(HTTPMethod method, const String& uri, const String& body = String());
+  const FakeResponse& lastResponse() const { return response_; }
+  static ESP8266WebServer* instance();
+
+ private:
+  struct Registration {
+    String uri;
+    HTTPMethod method;
+    THandlerFunction function;
+    RequestHandler* handler;
+  };
+
+  std::vector<Registration> handlers_;
+  THandlerFunction not_found_;
+  bool running_ = false;
+  String uri_;
+  HTTPMethod method_ = HTTP_GET;
+  std::map<std::string, String> args_;
+  std::map<std::string, String> pending_headers_;
+  FakeResponse response_;
+};
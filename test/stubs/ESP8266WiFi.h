@@ -0,0 +1,4 @@
+// 原理说明：主机测试不编译 wifi_manager.cpp，此头文件只为满足 wifi_manager.h 的包含关系。
+#pragma once
+
+#include <Arduino.h>
@@ -0,0 +1,45 @@
+// 原理说明：主机测试用的文件系统替身，文件内容保存在内存中，挂载结果可由测试控制。
+#pragma once
+
+#include <map>
+#include <string>
+
+#include <Arduino.h>
+
+class File {
+ public:
+  File() = default;
+  File(const std::string* content) : content_(content) {}
+
+  explicit operator bool() const { return content_ != nullptr; }
+  size_t size() const { return content_ != nullptr ? content_->size() : 0; }
+  const std::string& content() const { return *content_; }
+  void close() { content_ = nullptr; }
+
+ private:
+  const std::string* content_ = nullptr;
+};
+
+class FakeFs {
+ public:
+  bool begin() {
+    ++begin_calls;
+    mounted = mount_succeeds;
+    return mounted;
+  }
+  void end() { mounted = false; }
+  File open(const char* path, const char* mode) {
+    (void)mode;
+    if (!mounted) {
+      return File();
+    }
+    const auto it = files.find(path);
+    return it != files.end() ? File(&it->second) : File();
+  }
+
+  // 测试接口。
+  bool mount_succeeds = true;
+  bool mounted = false;
+  int begin_calls = 0;
+  std::map<std::string, std::string> files;
+};
@@ -0,0 +1,60 @@
+// 原理说明：主机测试用的串口替身，接收方向由测试注入字节，发送方向记录到内存供断言。
+#pragma once
+
+#include <deque>
+#include <string>
+
+#include "Stream.h"
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long baud_rate) { baud_rate_ = baud_rate; }
+  size_t setRxBufferSize(size_t size) {
+    rx_buffer_size_ = size;
+    return size;
+  }
+
+  int available() override { return static_cast<int>(rx_.size()); }
+  int read() override {
+    if (rx_.empty()) {
+      return -1;
+    }
+    const int ch = static_cast<uint8_t>(rx_.front());
+    rx_.pop_front();
+    return ch;
+  }
+  int peek() override { return rx_.empty() ? -1 : static_cast<uint8_t>(rx_.front()); }
+  size_t read(char* buffer, size_t size) { return readBytes(buffer, size); }
+  size_t read(uint8_t* buffer, size_t size) { return readBytes(buffer, size); }
+
+  size_t write(uint8_t byte) override {
+    tx_.push_back(static_cast<char>(byte));
+    return 1;
+  }
+  using Print::write;
+
+  // 与核心一致：读取后清除溢出标志。
+  bool hasOverrun() {
+    const bool overrun = overrun_;
+    overrun_ = false;
+    return overrun;
+  }
+
+  // 测试接口：注入待接收的字节；超出接收缓冲容量的部分按硬件行为直接丢弃，并置位溢出标志。
+  size_t inject(const char* data, size_t length);
+  size_t overflowedBytes() const { return overflowed_bytes_; }
+  const std::string& transmitted() const { return tx_; }
+  void clearTransmitted() { tx_.clear(); }
+  size_t rxBufferSize() const { return rx_buffer_size_; }
+  unsigned long baudRate() const { return baud_rate_; }
+
+ private:
+  std::deque<char> rx_;
+  std::string tx_;
+  size_t rx_buffer_size_ = 256;
+  size_t overflowed_bytes_ = 0;
+  bool overrun_ = false;
+  unsigned long baud_rate_ = 0;
+};
+
+extern HardwareSerial Serial;
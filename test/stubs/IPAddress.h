@@ -0,0 +1,34 @@
+// 原理说明：主机测试用的 IPAddress 替身，仅支持四段地址的比较与字符串化。
+#pragma once
+
+#include <cstdint>
+
+#include "WString.h"
+
+class IPAddress {
+ public:
+  IPAddress() = default;
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets_{a, b, c, d} {}
+
+  uint8_t operator[](int index) const { return octets_[index]; }
+  bool operator==(const IPAddress& other) const {
+    for (int i = 0; i < 4; ++i) {
+      if (octets_[i] != other.octets_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  bool operator!=(const IPAddress& other) const { return !(*this == other); }
+  String toString() const {
+    String text(static_cast<unsigned int>(octets_[0]));
+    for (int i = 1; i < 4; ++i) {
+      text += '.';
+      text += static_cast<unsigned int>(octets_[i]);
+    }
+    return text;
+  }
+
+ private:
+  uint8_t octets_[4] = {0, 0, 0, 0};
+};
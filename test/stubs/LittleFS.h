@@ -0,0 +1,6 @@
+// 原理说明：主机测试用的 LittleFS 替身。
+#pragma once
+
+#include "FS.h"
+
+extern FakeFs LittleFS;
@@ -0,0 +1,30 @@
+// 原理说明：主机测试用的 Print 替身，ArduinoJson 通过它把序列化结果写入串口。
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "WString.h"
+
+class Print {
+ public:
+  virtual ~Print() = default;
+  virtual size_t write(uint8_t byte) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (written < size && write(buffer[written]) == 1) {
+      ++written;
+    }
+    return written;
+  }
+  size_t write(const char* text) { return text != nullptr ? write(reinterpret_cast<const uint8_t*>(text), strlen(text)) : 0; }
+  size_t write(const char* buffer, size_t size) { return write(reinterpret_cast<const uint8_t*>(buffer), size); }
+  virtual void flush() {}
+
+  size_t print(const String& text) { return write(text.c_str(), text.length()); }
+  size_t print(const char* text) { return write(text); }
+  size_t print(char ch) { return write(static_cast<uint8_t>(ch)); }
+  size_t println() { return write('\n'); }
+  size_t println(const String& text) { return print(text) + println(); }
+};
@@ -0,0 +1,24 @@
+// 原理说明：主机测试用的 Stream 替身，只保留串口读取相关接口。
+#pragma once
+
+#include "Print.h"
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+      const int ch = read();
+      if (ch < 0) {
+        break;
+      }
+      buffer[count++] = static_cast<char>(ch);
+    }
+    return count;
+  }
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes(reinterpret_cast<char*>(buffer), length); }
+};
@@ -0,0 +1,169 @@
+// 原理说明：主机测试用的 Arduino String 替身，以 std::string 保存内容，只实现固件与 ArduinoJson 用到的接口；
+// 容量按 Arduino String 的方式记账（不足时按所需长度精确重新分配），并统计重新分配次数，用于发现逐段 += 的反复扩容。
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+class StringSumHelper;
+
+class String {
+ public:
+  String() = default;
+  String(const char* text) { *this = text; }
+  String(const char* text, size_t length) {
+    if (text != nullptr) {
+      ensureCapacity(length);
+      data_.assign(text, length);
+    }
+  }
+  String(const __FlashStringHelper* text) : String(reinterpret_cast<const char*>(text)) {}
+  String(const std::string& text) : String(text.data(), text.size()) {}
+  String(const String& other) : String(other.data_) {}
+  String(String&& other) noexcept { *this = static_cast<String&&>(other); }
+  explicit String(char ch) : data_(1, ch) {}
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(long long value, unsigned char base = 10);
+  explicit String(unsigned long long value, unsigned char base = 10);
+  explicit String(float value, unsigned char decimals = 2);
+  explicit String(double value, unsigned char decimals = 2);
+
+  String& operator=(const char* text) {
+    const char* source = text != nullptr ? text : "";
+    ensureCapacity(std::char_traits<char>::length(source));
+    data_ = source;
+    return *this;
+  }
+  String& operator=(const String& other) {
+    if (this != &other) {
+      ensureCapacity(other.data_.size());
+      data_ = other.data_;
+    }
+    return *this;
+  }
+  // 移动时接管对方的缓冲，不计分配。
+  String& operator=(String&& other) noexcept {
+    if (this != &other) {
+      data_ = static_cast<std::string&&>(other.data_);
+      capacity_ = other.capacity_;
+      other.data_.clear();
+      other.capacity_ = kSsoCapacity;
+    }
+    return *this;
+  }
+  String& operator=(const __FlashStringHelper* text) { return *this = reinterpret_cast<const char*>(text); }
+
+  const char* c_str() const { return data_.c_str(); }
+  unsigned int length() const { return static_cast<unsigned int>(data_.size()); }
+  bool isEmpty() const { return data_.empty(); }
+  bool reserve(unsigned int size) {
+    ensureCapacity(size);
+    data_.reserve(size);
+    return true;
+  }
+
+  bool concat(const String& text) { return concat(text.c_str(), text.length()); }
+  bool concat(const char* text) { return text != nullptr && concat(text, std::char_traits<char>::length(text)); }
+  bool concat(const char* text, unsigned int length) {
+    if (text == nullptr) {
+      return false;
+    }
+    ensureCapacity(data_.size() + length);
+    data_.append(text, length);
+    return true;
+  }
+  bool concat(const __FlashStringHelper* text) { return concat(reinterpret_cast<const char*>(text)); }
+  bool concat(char ch) {
+    ensureCapacity(data_.size() + 1);
+    data_.push_back(ch);
+    return true;
+  }
+  bool concat(unsigned char value) { return concat(String(value)); }
+  bool concat(int value) { return concat(String(value)); }
+  bool concat(unsigned int value) { return concat(String(value)); }
+  bool concat(long value) { return concat(String(value)); }
+  bool concat(unsigned long value) { return concat(String(value)); }
+  bool concat(float value) { return concat(String(value)); }
+  bool concat(double value) { return concat(String(value)); }
+
+  template <typename T>
+  String& operator+=(const T& value) {
+    concat(value);
+    return *this;
+  }
+
+  char operator[](unsigned int index) const { return index < data_.size() ? data_[index] : '\0'; }
+  char charAt(unsigned int index) const { return (*this)[index]; }
+
+  bool equals(const String& other) const { return data_ == other.data_; }
+  bool equals(const char* other) const { return data_ == (other != nullptr ? other : ""); }
+  bool operator==(const String& other) const { return equals(other); }
+  bool operator==(const char* other) const { return equals(other); }
+  bool operator!=(const String& other) const { return !equals(other); }
+  bool operator!=(const char* other) const { return !equals(other); }
+  bool operator<(const String& other) const { return data_ < other.data_; }
+
+  bool startsWith(const String& prefix) const { return data_.compare(0, prefix.data_.size(), prefix.data_) == 0; }
+  bool endsWith(const String& suffix) const {
+    return data_.size() >= suffix.data_.size() &&
+           data_.compare(data_.size() - suffix.data_.size(), suffix.data_.size(), suffix.data_) == 0;
+  }
+  int indexOf(char ch, unsigned int from = 0) const;
+  int indexOf(const String& text, unsigned int from = 0) const;
+  String substring(unsigned int begin) const { return substring(begin, length()); }
+  String substring(unsigned int begin, unsigned int end) const;
+  long toInt() const;
+  float toFloat() const;
+
+  const std::string& str() const { return data_; }
+
+  // 测试接口：进程内所有 String 的堆（重新）分配次数。
+  static uint32_t allocationCount() { return allocation_count_; }
+
+ private:
+  // ESP8266 核心 3.x 的 String 自带 SSO，11 字节以内不占堆。
+  static constexpr size_t kSsoCapacity = 11;
+
+  void ensureCapacity(size_t size) {
+    if (size > capacity_) {
+      capacity_ = size;
+      ++allocation_count_;
+    }
+  }
+
+  std::string data_;
+  size_t capacity_ = kSsoCapacity;
+  static inline uint32_t allocation_count_ = 0;
+};
+
+class StringSumHelper : public String {
+ public:
+  StringSumHelper(const String& text) : String(text) {}
+  StringSumHelper(const char* text) : String(text) {}
+};
+
+template <typename T>
+StringSumHelper operator+(const StringSumHelper& lhs, const T& rhs) {
+  StringSumHelper result(lhs);
+  result.concat(rhs);
+  return result;
+}
+
+template <typename T>
+StringSumHelper operator+(const String& lhs, const T& rhs) {
+  StringSumHelper result(lhs);
+  result.concat(rhs);
+  return result;
+}
+
+inline bool operator==(const char* lhs, const String& rhs) {
+  return rhs == lhs;
+}
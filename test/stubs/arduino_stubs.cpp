@@ -0,0 +1,210 @@
+// 原理说明：主机测试替身的实现部分，集中放置模拟时钟、String 数值转换、串口注入与 Web 请求分派。
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include <LittleFS.h>
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+unsigned long fake_now_ms = 0;
+ESP8266WebServer* current_server = nullptr;
+
+std::string formatInteger(unsigned long long magnitude, bool negative, unsigned char base) {
+  if (base < 2 || base > 36) {
+    base = 10;
+  }
+  std::string digits;
+  do {
+    const unsigned digit = static_cast<unsigned>(magnitude % base);
+    digits.insert(digits.begin(), static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10));
+    magnitude /= base;
+  } while (magnitude != 0);
+  if (negative) {
+    digits.insert(digits.begin(), '-');
+  }
+  return digits;
+}
+
+std::string formatSigned(long long value, unsigned char base) {
+  const bool negative = value < 0 && base == 10;
+  const unsigned long long magnitude =
+      negative ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+  return formatInteger(magnitude, negative, base);
+}
+
+std::string formatFloat(double value, unsigned char decimals) {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), value);
+  return buffer;
+}
+
+}  // namespace
+
+unsigned long millis() {
+  return fake_now_ms;
+}
+
+unsigned long micros() {
+  return fake_now_ms * 1000UL;
+}
+
+void delay(unsigned long ms) {
+  fake_now_ms += ms;
+}
+
+void yield() {}
+
+namespace fake_clock {
+
+void set(unsigned long ms) {
+  fake_now_ms = ms;
+}
+
+void advance(unsigned long ms) {
+  fake_now_ms += ms;
+}
+
+}  // namespace fake_clock
+
+EspClass ESP;
+HardwareSerial Serial;
+FakeFs LittleFS;
+
+String::String(unsigned char value, unsigned char base) : String(formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base) : String(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : String(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base) : String(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : String(formatInteger(value, false, base)) {}
+String::String(long long value, unsigned char base) : String(formatSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base) : String(formatInteger(value, false, base)) {}
+String::String(float value, unsigned char decimals) : String(formatFloat(value, decimals)) {}
+String::String(double value, unsigned char decimals) : String(formatFloat(value, decimals)) {}
+
+int String::indexOf(char ch, unsigned int from) const {
+  const size_t found = data_.find(ch, from);
+  return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+int String::indexOf(const String& text, unsigned int from) const {
+  const size_t found = data_.find(text.data_, from);
+  return found == std::string::npos ? -1 : static_cast<int>(found);
+}
+
+String String::substring(unsigned int begin, unsigned int end) const {
+  if (begin > end) {
+    const unsigned int swap = begin;
+    begin = end;
+    end = swap;
+  }
+  if (begin >= data_.size()) {
+    return String();
+  }
+  if (end > data_.size()) {
+    end = static_cast<unsigned int>(data_.size());
+  }
+  return String(data_.substr(begin, end - begin));
+}
+
+long String::toInt() const {
+  return atol(data_.c_str());
+}
+
+float String::toFloat() const {
+  return static_cast<float>(atof(data_.c_str()));
+}
+
+size_t HardwareSerial::inject(const char* data, size_t length) {
+  size_t accepted = 0;
+  while (accepted < length && rx_.size() < rx_buffer_size_) {
+    rx_.push_back(data[accepted++]);
+  }
+  if (accepted < length) {
+    overflowed_bytes_ += length - accepted;
+    overrun_ = true;
+  }
+  return accepted;
+}
+
+ESP8266WebServer::ESP8266WebServer(uint16_t port) {
+  (void)port;
+  current_server = this;
+}
+
+ESP8266WebServer::~ESP8266WebServer() {
+  for (const Registration& registration : handlers_) {
+    delete registration.handler;
+  }
+  if (current_server == this) {
+    current_server = nullptr;
+  }
+}
+
+ESP8266WebServer* ESP8266WebServer::instance() {
+  return current_server;
+}
+
+void ESP8266WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+  handlers_.push_back({uri, method, handler, nullptr});
+}
+
+void ESP8266WebServer::send(int code, const char* content_type, const String& content) {
+  response_.code = code;
+  response_.content_type = content_type;
+  response_.body = content;
+  response_.headers = pending_headers_;
+  pending_headers_.clear();
+}
+
+size_t ESP8266WebServer::streamFile(File& file, const String& content_type) {
+  send(200, content_type.c_str(), String(file.content()));
+  return file.size();
+}
+
+const FakeResponse& ESP8266WebServer::request(HTTPMethod method, const String& uri, const String& body) {
+  response_ = FakeResponse();
+  pending_headers_.clear();
+  args_.clear();
+  method_ = method;
+
+  const int query = uri.indexOf('?');
+  uri_ = query < 0 ? uri : uri.substring(0, query);
+  if (query >= 0) {
+    const String pairs = uri.substring(query + 1);
+    unsigned int start = 0;
+    while (start <= pairs.length()) {
+      int end = pairs.indexOf('&', start);
+      if (end < 0) {
+        end = pairs.length();
+      }
+      const String pair = pairs.substring(start, end);
+      const int equals = pair.indexOf('=');
+      if (pair.length() > 0) {
+        args_[(equals < 0 ? pair : pair.substring(0, equals)).str()] = equals < 0 ? String() : pair.substring(equals + 1);
+      }
+      start = end + 1;
+    }
+  }
+  if (body.length() > 0) {
+    args_["plain"] = body;
+  }
+
+  for (const Registration& registration : handlers_) {
+    if (registration.handler != nullptr) {
+      if (registration.handler->canHandle(method, uri_)) {
+        registration.handler->handle(*this, method, uri_);
+        return response_;
+      }
+      continue;
+    }
+    if (registration.uri == uri_ && (registration.method == HTTP_ANY || registration.method == method)) {
+      registration.function();
+      return response_;
+    }
+  }
+  if (not_found_) {
+    not_found_();
+  }
+  return response_;
+}
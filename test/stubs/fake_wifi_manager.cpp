@@ -0,0 +1,37 @@
+// 原理说明：主机测试用的 wifi_manager 替身，热点状态固定为已启动。
+#include "wifi_manager.h"
+
+namespace wifi_manager {
+
+void startAccessPoint(const char* ssid, const char* password) {
+  (void)ssid;
+  (void)password;
+}
+
+bool resumeAccessPoint(const char* ssid, const char* password) {
+  (void)ssid;
+  (void)password;
+  return false;
+}
+
+bool accessPointResumed() {
+  return false;
+}
+
+bool isConnected() {
+  return true;
+}
+
+IPAddress localIP() {
+  return IPAddress(192, 168, 4, 1);
+}
+
+uint8_t stationCount() {
+  return 1;
+}
+
+void setLowPower(bool enabled) {
+  (void)enabled;
+}
+
+}  // namespace wifi_manager